@@ -4,15 +4,24 @@
 # Copyright (c) 2016 Carl Gorringe (carl.gorringe.org)
 # 5/21/2016
 
+# 18/10/2026 - Added -r to run the demos with real-time scheduling
+# (FT_REALTIME, see src/realtime.h).
+
 use strict;
 use warnings;
+use Getopt::Std;
 
 {
+  my %opts;
+  getopts('r:', \%opts);
   if (scalar @ARGV < 1) {
     print STDERR "Schedule Flaschen-Taschen Demos\n";
-    print STDERR "Usage:\n  $0 playlist.txt\n";
+    print STDERR "Usage:\n  $0 [-r fifo[:prio]] playlist.txt\n";
+    print STDERR "  -r  real-time scheduling for the demos, e.g. fifo:60\n";
     exit(1);
   }
+  # the demos read it at startup, as if given --realtime
+  $ENV{FT_REALTIME} = $opts{r} if (defined $opts{r});
 
   my $file = $ARGV[0];
   open my $info, $file or die "Could not open $file: $!";
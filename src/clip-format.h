@@ -0,0 +1,168 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// clip-format
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Clip files hold the canvas output of a demo so that it can be played back
+// later by clip-player without rendering anything. The layout is meant to be
+// memory-mapped and read in place:
+//
+//  ClipHeader
+//  ClipFrame, runs[size]
+//  ClipFrame, runs[size]
+//  ...
+//
+// The pixels of a frame are delta-compressed against the previous frame as
+// runs of (uint16 skip, uint16 count, count * RGB). A keyframe is encoded
+// against a black canvas; the first frame and any frame that changes size is
+// a keyframe. All fields are little-endian, as written on x86 and the Pi.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef CLIP_FORMAT_H
+#define CLIP_FORMAT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#define CLIP_MAGIC "FTCLIP01"
+#define CLIP_KEYFRAME 0x01
+#define CLIP_MAX_RUN 0xFFFF
+
+struct ClipHeader {
+    char magic[8];
+    uint16_t width, height;     // size of the first frame
+    uint32_t reserved;
+} __attribute__((packed));
+
+struct ClipFrame {
+    uint32_t size;              // bytes of run data following this header
+    uint32_t time_ms;           // demo clock when the frame was sent
+    uint16_t width, height;
+    int16_t off_x, off_y;
+    uint8_t layer;
+    uint8_t flags;              // CLIP_KEYFRAME
+    uint16_t reserved;
+} __attribute__((packed));
+
+static_assert(sizeof(ClipHeader) == 16, "ClipHeader must stay 16 bytes");
+static_assert(sizeof(ClipFrame) == 20, "ClipFrame must stay 20 bytes");
+
+inline void clipPutRun(std::vector<uint8_t> &out, int skip, int count, const uint8_t *rgb) {
+    const uint16_t run[2] = { (uint16_t)skip, (uint16_t)count };
+    const uint8_t *p = (const uint8_t *)run;
+    out.insert(out.end(), p, p + sizeof(run));
+    out.insert(out.end(), rgb, rgb + count * 3);
+}
+
+// Appends the runs turning prev into cur (both npixels RGB pixels) to out.
+inline void clipEncodeRuns(const uint8_t *prev, const uint8_t *cur, int npixels, std::vector<uint8_t> &out) {
+    int i = 0;
+    while (i < npixels) {
+        int skip = 0;
+        while (i < npixels && skip < CLIP_MAX_RUN && memcmp(prev + i*3, cur + i*3, 3) == 0) {
+            i++; skip++;
+        }
+        int start = i;
+        while (i < npixels && (i - start) < CLIP_MAX_RUN && memcmp(prev + i*3, cur + i*3, 3) != 0) {
+            i++;
+        }
+        if (i > start || skip == CLIP_MAX_RUN) {
+            clipPutRun(out, skip, i - start, cur + start*3);
+        }
+    }
+}
+
+// Applies runs to pixels. Calls set(index, rgb) for every changed pixel so the
+// player can write straight into its canvas. Returns false on a corrupt frame.
+template <class SetFn>
+bool clipDecodeRuns(const uint8_t *runs, uint32_t size, int npixels, SetFn set) {
+    const uint8_t *p = runs, *end = runs + size;
+    int i = 0;
+    while (p + 4 <= end) {
+        uint16_t run[2];
+        memcpy(run, p, sizeof(run));
+        p += sizeof(run);
+        i += run[0];
+        if (i + run[1] > npixels || p + run[1] * 3 > end) {
+            return false;
+        }
+        for (int n=0; n < run[1]; n++, i++, p += 3) {
+            set(i, p);
+        }
+    }
+    return p == end;
+}
+
+// Writes a clip file frame by frame.
+class ClipWriter {
+public:
+    ~ClipWriter() { if (file_) fclose(file_); }
+
+    bool Open(const char *filename) {
+        file_ = fopen(filename, "wb");
+        if (!file_) {
+            perror(filename);
+            return false;
+        }
+        return true;
+    }
+
+    void Write(uint32_t time_ms, int width, int height, int off_x, int off_y, int layer,
+               const uint8_t *pixels) {
+        if (!file_) return;
+        if (time_ms < time_ms_) time_ms = time_ms_;  // keep time monotonic
+        time_ms_ = time_ms;
+        const int npixels = width * height;
+        ClipFrame frame = { 0, time_ms, (uint16_t)width, (uint16_t)height,
+                            (int16_t)off_x, (int16_t)off_y, (uint8_t)layer, 0, 0 };
+        if (width != width_ || height != height_) {
+            if (width_ < 0) {
+                ClipHeader header;
+                memcpy(header.magic, CLIP_MAGIC, sizeof(header.magic));
+                header.width = width;
+                header.height = height;
+                header.reserved = 0;
+                fwrite(&header, sizeof(header), 1, file_);
+            }
+            width_ = width; height_ = height;
+            prev_.assign(npixels * 3, 0);
+            frame.flags |= CLIP_KEYFRAME;
+        }
+        runs_.clear();
+        clipEncodeRuns(prev_.data(), pixels, npixels, runs_);
+        memcpy(prev_.data(), pixels, npixels * 3);
+
+        frame.size = runs_.size();
+        fwrite(&frame, sizeof(frame), 1, file_);
+        fwrite(runs_.data(), 1, runs_.size(), file_);
+        fflush(file_);
+    }
+
+private:
+    FILE *file_ = NULL;
+    int width_ = -1, height_ = -1;
+    uint32_t time_ms_ = 0;
+    std::vector<uint8_t> prev_;
+    std::vector<uint8_t> runs_;
+};
+
+#endif  // CLIP_FORMAT_H
@@ -0,0 +1,353 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// clip-player
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+// 18/10/2026 - Added real-time scheduling, CPU pinning and the jitter report
+// (-R, -C, -J, realtime.h).
+// 18/10/2026 - Frames too big for one UDP packet are split as the demos do
+// (--packet-size, frame-packets.h).
+//
+// Plays a clip recorded by any demo with --record (see clip-format.h). The
+// clip is memory-mapped and only the changed pixels of each frame are applied
+// to the canvas, which is sent at the recorded time using absolute sleeps so
+// the pacing doesn't drift. Expensive scenes can be pre-rendered offline:
+//
+//  ./fractal --fixed-clock -t 300 --record fractal.ftc
+//  ./clip-player -h ft.noise fractal.ftc
+//
+// On a busy host, -R fifo runs the player with real-time priority and the
+// clip locked in memory, and -J shows how late the frames went out:
+//
+//  ./clip-player -R fifo:60 -C 3 -J fractal.ftc
+//
+// How to run:
+//
+// To see command line options:
+//  ./clip-player -?
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#include "udp-flaschen-taschen.h"
+#include "clip-format.h"
+#include "realtime.h"
+#include "frame-packets.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+
+volatile bool interrupt_received = false;
+static void InterruptHandler(int signo) {
+    interrupt_received = true;
+}
+
+// ------------------------------------------------------------------------------------------
+// Command Line Options
+
+// option vars
+const char *opt_hostname = NULL;
+int opt_layer = -1;             // -1 = as recorded
+int opt_xoff=0, opt_yoff=0;
+int opt_loops = 0;              // 0 = forever
+double opt_speed = 1.0;
+int opt_policy = SCHED_OTHER;   // -R
+int opt_priority = 0;
+std::vector<int> opt_cpus;      // -C, empty = any
+bool opt_jitter = false;        // -J
+int opt_packet_size = FRAME_PACKET_MAX;
+
+enum { OPT_PACKET_SIZE = 0x100 };
+
+static const struct option long_options[] = {
+    { "packet-size", required_argument, NULL, OPT_PACKET_SIZE },
+    { NULL, 0, NULL, 0 },
+};
+
+int usage(const char *progname) {
+
+    fprintf(stderr, "Clip player (c) 2026 James Crowley (judgejc.net)\n");
+    fprintf(stderr, "Usage: %s [options] <clip>\n", progname);
+    fprintf(stderr, "Options:\n"
+        "\t-g +<X>+<Y>    : Offset added to the recorded offsets. (default +0+0)\n"
+        "\t-l <layer>     : Layer 0-15. (default as recorded)\n"
+        "\t-h <host>      : Flaschen-Taschen display hostname. (FT_DISPLAY)\n"
+        "\t-n <loops>     : Play the clip n times. (default 0 = forever)\n"
+        "\t-s <speed>     : Playback speed factor. (default 1.0)\n"
+        "\t-R <fifo|rr|off>[:<prio>] : Real-time scheduling, memory locked. (FT_REALTIME)\n"
+        "\t-C <list>      : Pin to CPUs, e.g. 2-3.\n"
+        "\t-J             : Print how late frames were sent at exit.\n"
+        "\t--packet-size <bytes> : Split bigger frames into several packets. (default 65507)\n"
+    );
+    return 1;
+}
+
+int cmdLine(int argc, char *argv[]) {
+
+    // command line options
+    int opt;
+    const char *env = getenv("FT_REALTIME");
+    if (env && !realtimeParsePolicy(env, &opt_policy, &opt_priority)) {
+        fprintf(stderr, "Invalid FT_REALTIME '%s'\n", env);
+    }
+
+    while ((opt = getopt_long(argc, argv, "?g:l:h:n:s:R:C:J", long_options, NULL)) != -1) {
+        switch (opt) {
+        case '?':  // help
+            return usage(argv[0]);
+            break;
+        case 'g':  // offset
+            if (sscanf(optarg, "%d%d", &opt_xoff, &opt_yoff) != 2) {
+                fprintf(stderr, "Invalid offset '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'l':  // layer
+            if (sscanf(optarg, "%d", &opt_layer) != 1 || opt_layer < 0 || opt_layer >= 16) {
+                fprintf(stderr, "Invalid layer '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'h':  // hostname
+            opt_hostname = strdup(optarg); // leaking. Ignore.
+            break;
+        case 'n':  // loops
+            if (sscanf(optarg, "%d", &opt_loops) != 1 || opt_loops < 0) {
+                fprintf(stderr, "Invalid loops '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 's':  // speed
+            if (sscanf(optarg, "%lf", &opt_speed) != 1 || opt_speed <= 0) {
+                fprintf(stderr, "Invalid speed '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'R':  // real-time scheduling
+            if (!realtimeParsePolicy(optarg, &opt_policy, &opt_priority)) {
+                fprintf(stderr, "Invalid realtime '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'C':  // CPUs
+            if (!realtimeParseCpus(optarg, &opt_cpus)) {
+                fprintf(stderr, "Invalid CPU list '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'J':  // jitter report
+            opt_jitter = true;
+            break;
+        case OPT_PACKET_SIZE:
+            if (sscanf(optarg, "%d", &opt_packet_size) != 1 || opt_packet_size < FRAME_PACKET_MIN
+                || opt_packet_size > FRAME_PACKET_MAX) {
+                fprintf(stderr, "Invalid packet size '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        default:
+            return usage(argv[0]);
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "Missing clip file\n");
+        return usage(argv[0]);
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------
+
+// True if the frame's runs fit its pixels, its time doesn't go back, and a
+// frame that isn't a keyframe has the size of the one before it.
+bool checkFrame(const ClipFrame *frame, const ClipFrame *prev) {
+    if (prev && frame->time_ms < prev->time_ms) {
+        return false;
+    }
+    if (!(frame->flags & CLIP_KEYFRAME)
+        && (!prev || frame->width != prev->width || frame->height != prev->height)) {
+        return false;
+    }
+    return clipDecodeRuns((const uint8_t *)(frame + 1), frame->size, frame->width * frame->height,
+                          [](int i, const uint8_t *rgb) {});
+}
+
+// Builds the list of frames in the mapped clip. Stops at a truncated frame,
+// e.g. when the recording demo was killed mid-write, and at a corrupt one,
+// so playback loops over the frames before it.
+bool indexClip(const char *filename, const uint8_t *data, size_t size,
+               std::vector<const ClipFrame *> &frames) {
+    if (size < sizeof(ClipHeader) || memcmp(data, CLIP_MAGIC, 8) != 0) {
+        return false;
+    }
+    size_t pos = sizeof(ClipHeader);
+    while (pos + sizeof(ClipFrame) <= size) {
+        const ClipFrame *frame = (const ClipFrame *)(data + pos);
+        if (pos + sizeof(ClipFrame) + frame->size > size) break;
+        if (!checkFrame(frame, frames.empty() ? NULL : frames.back())) {
+            fprintf(stderr, "%s: corrupt frame %zu, playing the frames before it\n",
+                    filename, frames.size());
+            break;
+        }
+        frames.push_back(frame);
+        pos += sizeof(ClipFrame) + frame->size;
+    }
+    return !frames.empty();
+}
+
+// Sends the canvas, as several packets if it doesn't fit in one.
+void sendCanvas(UDPFlaschenTaschen *canvas, int socket, FramePacketSender &packets,
+                int x, int y, int z) {
+    if (framePacketsNeeded(canvas->width(), canvas->height(), opt_packet_size)) {
+        packets.Send(socket, (const uint8_t *)&canvas->GetPixel(0, 0), canvas->width(), canvas->height(),
+                     opt_packet_size, x, y, z);
+    }
+    else {
+        canvas->SetOffset(x, y, z);
+        canvas->Send();
+    }
+}
+
+void addNsec(struct timespec *ts, long long nsec) {
+    nsec += ts->tv_nsec;
+    ts->tv_sec += nsec / 1000000000LL;
+    ts->tv_nsec = nsec % 1000000000LL;
+}
+
+int main(int argc, char *argv[]) {
+
+    // parse command line
+    if (int e = cmdLine(argc, argv)) { return e; }
+
+    // map the clip
+    const char *filename = argv[optind];
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(filename);
+        return 1;
+    }
+    const uint8_t *data = (const uint8_t *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror(filename);
+        return 1;
+    }
+    madvise((void *)data, st.st_size, MADV_SEQUENTIAL);
+
+    std::vector<const ClipFrame *> frames;
+    if (!indexClip(filename, data, st.st_size, frames)) {
+        fprintf(stderr, "%s: not a clip file\n", filename);
+        return 1;
+    }
+
+    // length of one loop: the last frame is shown as long as the one before it,
+    // or 100 ms if that was shown for no time
+    const size_t last = frames.size() - 1;
+    const uint32_t last_delay = (last > 0 && frames[last]->time_ms > frames[last - 1]->time_ms)
+        ? frames[last]->time_ms - frames[last - 1]->time_ms : 100;
+    const long long loop_nsec = (long long)((frames[last]->time_ms + last_delay) * 1000000LL / opt_speed);
+
+    // real time: locking also faults in the whole clip
+    if (opt_policy != SCHED_OTHER) {
+        realtimeLockMemory();
+    }
+    if (opt_policy != SCHED_OTHER || !opt_cpus.empty()) {
+        realtimeSetThread(pthread_self(), opt_policy, opt_priority, opt_cpus);
+    }
+    JitterReport jitter;
+
+    // open socket and create our canvas
+    const int socket = OpenFlaschenTaschenSocket(opt_hostname);
+    UDPFlaschenTaschen *canvas = NULL;
+    FramePacketSender packets;
+    int x = 0, y = 0, z = 0;
+
+    // handle break
+    signal(SIGTERM, InterruptHandler);
+    signal(SIGINT, InterruptHandler);
+
+    struct timespec loop_start;
+    clock_gettime(CLOCK_MONOTONIC, &loop_start);
+
+    bool failed = false;
+    for (int loop=0; (opt_loops == 0 || loop < opt_loops) && !interrupt_received && !failed; loop++) {
+        for (size_t i=0; i < frames.size() && !interrupt_received; i++) {
+            const ClipFrame *frame = frames[i];
+
+            if (frame->flags & CLIP_KEYFRAME) {
+                if (!canvas || canvas->width() != frame->width || canvas->height() != frame->height) {
+                    delete canvas;
+                    canvas = new UDPFlaschenTaschen(socket, frame->width, frame->height);
+                }
+                canvas->Clear();
+            }
+            // checked by indexClip()
+            const int width = frame->width;
+            clipDecodeRuns((const uint8_t *)(frame + 1), frame->size, width * frame->height,
+                [canvas, width](int i, const uint8_t *rgb) {
+                    canvas->SetPixel(i % width, i / width, Color(rgb[0], rgb[1], rgb[2]));
+                });
+
+            // wait until the frame is due
+            struct timespec due = loop_start;
+            addNsec(&due, (long long)(frame->time_ms * 1000000LL / opt_speed));
+            int e;
+            while ((e = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL)) == EINTR
+                   && !interrupt_received) {}
+            if (e != 0 && e != EINTR) {
+                fprintf(stderr, "%s: frame %zu: clock_nanosleep: %s\n", filename, i, strerror(e));
+                failed = true;
+                break;
+            }
+            if (opt_jitter) {
+                struct timespec now;
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                jitter.Add((double)(now.tv_sec - due.tv_sec) + (now.tv_nsec - due.tv_nsec) / 1000000000.0);
+            }
+
+            x = frame->off_x + opt_xoff;
+            y = frame->off_y + opt_yoff;
+            z = (opt_layer < 0) ? frame->layer : opt_layer;
+            sendCanvas(canvas, socket, packets, x, y, z);
+        }
+        addNsec(&loop_start, loop_nsec);
+    }
+
+    // clear canvas on exit
+    if (canvas) {
+        canvas->Clear();
+        sendCanvas(canvas, socket, packets, x, y, z);
+    }
+    if (opt_jitter) {
+        jitter.Print(stderr, "frames");
+    }
+
+    if (interrupt_received || failed) return 1;
+    return 0;
+}
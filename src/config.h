@@ -1,25 +1,25 @@
-
-// config settings
-// Copyright (c) 2019 Carl Gorringe (carl.gorringe.org)
-// Modified Version 2025 James Crowley (judgejc.net)
-// https://github.com/cgorringe/ft-demos
-// 6/23/2016
-//
-// Modified Version 2025 James Crowley (judgejc.net)
-// https://github.com/judgejc/ft-demos
-//
-// 30/12/2025 - Update default display width and height to 64x64 for Waveshare LED matrix panels.
-//
-// Shared settings used in all the demos.
-//
-
-#ifndef CONFIG_H
-#define CONFIG_H
-
-// Defaults
-#define DISPLAY_WIDTH  64  // Width of Waveshare LED matrix panel
-#define DISPLAY_HEIGHT 64  // Height of Waveshare LED matrix panel
-#define DISPLAY_XOFF 0
-#define DISPLAY_YOFF 0
-
-#endif  // CONFIG_H
+
+// config settings
+// Copyright (c) 2019 Carl Gorringe (carl.gorringe.org)
+// Modified Version 2025 James Crowley (judgejc.net)
+// https://github.com/cgorringe/ft-demos
+// 6/23/2016
+//
+// Modified Version 2025 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 30/12/2025 - Update default display width and height to 64x64 for Waveshare LED matrix panels.
+//
+// Shared settings used in all the demos.
+//
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Defaults
+#define DISPLAY_WIDTH  64  // Width of Waveshare LED matrix panel
+#define DISPLAY_HEIGHT 64  // Height of Waveshare LED matrix panel
+#define DISPLAY_XOFF 0
+#define DISPLAY_YOFF 0
+
+#endif  // CONFIG_H
@@ -0,0 +1,667 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// demo-kernels
+// Copyright (c) 2016-2020 Carl Gorringe (carl.gorringe.org)
+// https://github.com/cgorringe/ft-demos
+//
+// Modified Version 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Moved the hot inner loops out of the individual demos so that
+// they can be shared with the kernel-bench microbenchmark.
+// 18/10/2026 - Templated blur, fire, life and matrix on the canvas size with
+// pre-instantiated versions for the common geometries. Fire no longer reads
+// past the end of the pixel buffer.
+// 18/10/2026 - Fractal, zoom, plasma, down-sampling and the palette copy are
+// split into tiles over the shared thread pool (thread-pool.h).
+// 18/10/2026 - blurFire() only burns upwards; for the leftward fire of blur
+// -o 1, blur.cc runs it on a copy of the frame turned a quarter.
+// 18/10/2026 - Life's scratch buffer and Buffer2D are heap-allocated, aligned
+// PixelBuffers (pixel-buffer.h).
+// 18/10/2026 - The fractal can be computed at 1x instead of 2x the output
+// resolution, for the frame governor.
+// 18/10/2026 - Added 1-D kernels for LED strips (height 1): blur3() and
+// blurFire() switch to blurStrip(), and runRuleStrip() is an elementary
+// cellular automaton for life.
+// 18/10/2026 - The plasma kernels and the anti-aliased line are in fixed point
+// (fixed-point.h) instead of float and double.
+// 18/10/2026 - Added initPlasmaTables(), built with the vectorized batch trig
+// from fast-trig.h instead of libm per table cell.
+// 18/10/2026 - Added copyColorPixels() for demos that draw into a color buffer.
+// 18/10/2026 - blur3(), life, matrix and the strip kernels are cell functions
+// run by the stencil engine (stencil.h).
+// 18/10/2026 - copyPalettePixels() and copyColorPixels() into a Surface.
+//
+// Hot inner loops used by the demos: blur, fire, life, matrix rain, fractal
+// zoom, plasma sampling, supersample down-sampling, anti-aliased lines and the
+// palette copy loop. Everything here is header-only so each demo still builds
+// from a single source file.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef DEMO_KERNELS_H
+#define DEMO_KERNELS_H
+
+#include "udp-flaschen-taschen.h"
+#include "thread-pool.h"
+#include "pixel-buffer.h"
+#include "fixed-point.h"
+#include "fast-trig.h"
+#include "stencil.h"
+#include "surface.h"
+
+#include <stdint.h>
+#include <strings.h>
+#include <math.h>
+#include <vector>
+
+#define KERNEL_TILE 16  // tile size for the thread pool
+
+// ------------------------------------------------------------------------------------------
+// Blur (blur)
+
+// Pixel and the ones right, below and below right, / 4, dropped by decay.
+struct Blur3Kernel {
+    static constexpr bool kForward = true;
+    uint8_t decay;
+    inline uint8_t operator()(const StencilCells<uint8_t> &n) const {
+        const uint8_t dot = (uint8_t)((n.c + n.e + n.s + n.se) >> 2);
+        // max then subtract, so it stays a byte operation when vectorized
+        return (uint8_t)(((dot > decay) ? dot : decay) - decay);
+    }
+};
+
+// Blur that works without the black border.
+template <int W, int H>
+inline void blur3Sized(int w, int h, uint8_t pixels[]) {
+
+    const int width = W ? W : w;
+    const int height = H ? H : h;
+
+    // beyond the right and bottom borders is black
+    stencilInPlace(pixels, width, height, STENCIL_ZERO, Blur3Kernel{ 8 });
+    // last lower-right corner pixel
+    pixels[width * height - 1] = 0;
+}
+
+// Blur for fire effect.
+template <int W, int H>
+inline void blurFireSized(int w, int h, uint8_t pixels[]) {
+
+    const int width = W ? W : w;
+    const int height = H ? H : h;
+
+    const int step = 4;
+    int size = width * (height - 1) - 1;
+    uint8_t dot;
+
+    // The last rows read up to one row past the end of the buffer; that row is
+    // taken as black so the fire is the same on every run.
+    const int end = width * height;
+    const int safe = (end - 2*width - 1 < size) ? end - 2*width - 1 : size;
+    auto below = [pixels, end](int j) { return (j < end) ? pixels[j] : 0; };
+
+    // flame upwards only; callers turn the frame for other directions. The left
+    // and right neighbours at the borders come from the rows either side, as
+    // the pixels are walked as one array.
+    for (int i=1; i < size; i++) {
+        const int bottom = (i < safe)
+            ? pixels[i + 2*width - 1] + pixels[i + 2*width] + pixels[i + 2*width + 1]
+            : below(i + 2*width - 1) + below(i + 2*width) + below(i + 2*width + 1);
+        dot = (uint8_t)(( pixels[i - 1] + pixels[i + 1] + pixels[i + width - 1] + pixels[i + width]
+            + pixels[i + width + 1] + bottom
+            ) >> 3) & 0xFF;
+        if (dot <= step) { dot = 0; } else { dot -= step; }
+        pixels[i] = dot;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Game of Life (life)
+
+// Conway's rules on the eight neighbours; any non-zero cell is alive.
+struct LifeKernel {
+    inline uint8_t operator()(const StencilCells<uint8_t> &n) const {
+        const int count = (n.nw != 0) + (n.n != 0) + (n.ne != 0)
+                        + (n.w != 0)                + (n.e != 0)
+                        + (n.sw != 0) + (n.s != 0) + (n.se != 0);
+        return (count == 3 || (count == 2 && n.c));
+    }
+};
+
+template <int W, int H>
+inline void runGameOfLifeSized(int w, int h, uint8_t pixels[]) {
+
+    const int width = W ? W : w;
+    const int height = H ? H : h;
+
+    // neighbours wrap around the edges
+    stencilInPlace(pixels, width, height, STENCIL_WRAP, LifeKernel());
+}
+
+// ------------------------------------------------------------------------------------------
+// Matrix rain (matrix)
+
+// A white (255) pixel moves down a row; everything else fades by fade_step.
+struct MatrixKernel {
+    int fade_step;
+    inline uint8_t operator()(const StencilCells<uint8_t> &n) const {
+        if (n.n == 255) { return 255; }
+        return (n.c > fade_step) ? n.c - fade_step : 0;
+    }
+};
+
+template <int W, int H>
+inline void runMatrixSized(int w, int h, int fade_step, uint8_t pixels[]) {
+
+    const int width = W ? W : w;
+    const int height = H ? H : h;
+
+    stencilInPlace(pixels, width, height, STENCIL_ZERO, MatrixKernel{ fade_step });
+}
+
+// ------------------------------------------------------------------------------------------
+// LED strips (height 1)
+//
+// A one pixel high canvas has no rows for the 2-D kernels to mix, so these
+// work along the strip instead.
+
+// Blurs a strip with a 1-2-1 kernel and fades it by decay. Beyond the ends is
+// black.
+struct StripBlurKernel {
+    int decay;
+    inline uint8_t operator()(const StencilCells<uint8_t> &n) const {
+        const int dot = (n.w + 2 * n.c + n.e) >> 2;
+        return (dot <= decay) ? 0 : dot - decay;
+    }
+};
+
+inline void blurStrip(int width, int decay, uint8_t pixels[]) {
+    stencilInPlace(pixels, width, 1, STENCIL_ZERO, StripBlurKernel{ decay });
+}
+
+// One generation of an elementary cellular automaton: a cell becomes bit
+// (left << 2 | self << 1 | right) of rule, Wolfram's numbering (30 is the
+// chaotic pattern in fsa.py). The ends wrap around.
+struct RuleStripKernel {
+    int rule;
+    inline uint8_t operator()(const StencilCells<uint8_t> &n) const {
+        return (rule >> ((n.w != 0) << 2 | (n.c != 0) << 1 | (n.e != 0))) & 1;
+    }
+};
+
+inline void runRuleStrip(int width, int rule, uint8_t pixels[]) {
+    stencilInPlace(pixels, width, 1, STENCIL_WRAP, RuleStripKernel{ rule });
+}
+
+// ------------------------------------------------------------------------------------------
+// Geometry dispatch
+//
+// The kernels above are templated on the canvas size so that for the sizes we
+// run in production the strides are compile-time constants: indexing is
+// constant-folded, the life wrap-around modulos become cheap and the loops can
+// be unrolled and vectorized. W = H = 0 is the generic version which uses the
+// runtime size. The plain functions below pick the matching instantiation.
+
+template <class Fn> struct SizedKernel {
+    int width, height;        // 0x0 = generic, matches any size
+    Fn fn;
+};
+
+// Flaschen-Taschen (45x35), one and two Waveshare panels, bookcase strip.
+#define SIZED_KERNEL_TABLE(kernel) {                                    \
+        { 45, 35, kernel<45, 35> }, { 64, 64, kernel<64, 64> },         \
+        { 128, 64, kernel<128, 64> }, { 810, 1, kernel<810, 1> },       \
+        { 0, 0, kernel<0, 0> } }
+
+template <class Fn, size_t N>
+inline Fn selectKernel(const SizedKernel<Fn> (&table)[N], int width, int height) {
+    for (size_t i=0; i < N - 1; i++) {
+        if (table[i].width == width && table[i].height == height) {
+            return table[i].fn;
+        }
+    }
+    return table[N - 1].fn;
+}
+
+inline void blur3(int width, int height, uint8_t pixels[]) {
+    if (height == 1) { blurStrip(width, 8, pixels); return; }
+    static const SizedKernel<void (*)(int, int, uint8_t[])> table[] = SIZED_KERNEL_TABLE(blur3Sized);
+    selectKernel(table, width, height)(width, height, pixels);
+}
+
+inline void blurFire(int width, int height, uint8_t pixels[]) {
+    if (height == 1) { blurStrip(width, 4, pixels); return; }
+    static const SizedKernel<void (*)(int, int, uint8_t[])> table[] = SIZED_KERNEL_TABLE(blurFireSized);
+    selectKernel(table, width, height)(width, height, pixels);
+}
+
+inline void runGameOfLife(int width, int height, uint8_t pixels[]) {
+    static const SizedKernel<void (*)(int, int, uint8_t[])> table[] = SIZED_KERNEL_TABLE(runGameOfLifeSized);
+    selectKernel(table, width, height)(width, height, pixels);
+}
+
+inline void runMatrix(int width, int height, int fade_step, uint8_t pixels[]) {
+    static const SizedKernel<void (*)(int, int, int, uint8_t[])> table[] = SIZED_KERNEL_TABLE(runMatrixSized);
+    selectKernel(table, width, height)(width, height, fade_step, pixels);
+}
+
+// ------------------------------------------------------------------------------------------
+// Mandelbrot zoom (fractal)
+
+// State of an in-progress fractal computation. The fractal is computed at
+// scale (normally twice) the output resolution into frac1 a few lines at a
+// time, while the previously completed fractal in frac2 is zoomed onto the
+// display. scale only takes effect at startFractal().
+struct FractalState {
+    int width, height;       // output size, buffers are (2*width) x (2*height)
+    uint8_t *frac1, *frac2;
+    double *re;              // real part of each column, (2*width)
+    double dr, di, pr, pi, sr, si;
+    long offs;
+    int scale = 2;           // 1 or 2, for the next startFractal()
+    int scale1 = 2, scale2 = 2;     // resolution of frac1 and frac2
+};
+
+// init fractal computation (MUST REDO)
+inline void startFractal(FractalState &f, double sr, double si, double er, double ei) {
+    // compute deltas for interpolation in complex plane
+    f.scale1 = f.scale;
+    f.dr = (er - sr) / (f.width * (float)f.scale1);
+    f.di = (ei - si) / (f.height * (float)f.scale1);
+    // remember start values
+    f.pr = sr;
+    f.pi = si;
+    f.sr = sr;
+    f.si = si;
+    f.offs = 0;
+    // the columns are the same on every line; accumulate them once, in the
+    // same order as the original per-line loop did
+    double pr = sr;
+    for (int i=0; i < (f.width * f.scale1); i++) {
+        f.re[i] = pr;
+        pr += f.dr;
+    }
+}
+
+// compute 2 lines of fractal, 1 at scale 1 (MUST REDO)
+inline void computeFractal(FractalState &f) {
+    const int fwidth = f.width * f.scale1;
+    const long size = (long)fwidth * f.height * f.scale1;
+    if ((f.offs + 1) >= size) {
+        return;
+    }
+    const int lines = (size - f.offs < (long)f.scale1 * fwidth) ? 1 : f.scale1;
+    const double line_pi[2] = { f.pi, f.pi + f.di };
+    uint8_t *out = f.frac1 + f.offs;
+    const double *re = f.re;
+
+    parallelForTiles(fwidth, lines, KERNEL_TILE, [&](const Tile &t) {
+        for (int j=t.y0; j < t.y1; j++) {
+            for (int i=t.x0; i < t.x1; i++) {
+                uint8_t c = 0;
+                double vi = line_pi[j], vr = re[i], nvi, nvr;
+                // loop until distance is above 2, or counter hits limit
+                while ((vr*vr + vi*vi < 4) && (c < 255)) {
+                    // compute Z(n+1) given Z(n)
+                    nvr = vr*vr - vi*vi + re[i];
+                    nvi = 2 * vi * vr + line_pi[j];
+                    // that becomes Z(n)
+                    vi = nvi;
+                    vr = nvr;
+                    c++;
+                }
+                // store color
+                out[j * fwidth + i] = c;
+            }
+        }
+    });
+
+    f.offs += (long)lines * fwidth;
+    f.pi = line_pi[lines - 1];
+    if (f.offs < size) {
+        // interpolate Y
+        f.pi += f.di;
+    }
+}
+
+// finished computation, swap buffers
+inline void finishFractal(FractalState &f) {
+    uint8_t *tmp = f.frac1;
+    f.frac1 = f.frac2;
+    f.frac2 = tmp;
+    const int scale = f.scale1;
+    f.scale1 = f.scale2;
+    f.scale2 = scale;
+}
+
+inline void zoomFractal(const FractalState &f, double z, uint8_t pixels[]) {
+
+    // z = 0.0 to 1.0
+    const uint8_t *frac = f.frac2;
+    const int fwidth = f.width * f.scale2;
+    const int fheight = f.height * f.scale2;
+    const int owidth = f.width;
+    int width = (int)((fwidth<<16)/(256.0f*(1+z)))<<8,
+        height = (int)((fheight<<16)/(256.0f*(1+z)))<<8,
+        startx = ((fwidth<<16)-width)>>1,
+        starty = ((fheight<<16)-height)>>1,
+        deltax = width / f.width,
+        deltay = height / f.height;
+    parallelForTiles(f.width, f.height, KERNEL_TILE, [&](const Tile &t) {
+        for (int j=t.y0; j < t.y1; j++) {
+            const int py = starty + j * deltay;
+            // the row below, held at the last row (only reached at scale 1)
+            const long below = (long)(((py>>16)+1 < fheight) ? (py>>16)+1 : fheight-1) * fwidth;
+            int px = startx + t.x0 * deltax;
+            long offs = (long)j * owidth + t.x0;
+            for (int i=t.x0; i < t.x1; i++) {
+                // bilinear filter
+                pixels[offs] =
+                    ( frac[(py>>16)*fwidth+(px>>16)] * (0x100-((py>>8)&0xff)) * (0x100-((px>>8)&0xff))
+                    + frac[(py>>16)*fwidth+((px>>16)+1)] * (0x100-((py>>8)&0xff)) * ((px>>8)&0xff)
+                    + frac[below+(px>>16)] * ((py>>8)&0xff) * (0x100-((px>>8)&0xff))
+                    + frac[below+((px>>16)+1)] * ((py>>8)&0xff) * ((px>>8)&0xff) ) >> 16;
+                // interpolate X
+                px += deltax;
+                offs++;
+            }
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------
+// Plasma (plasma, plasma2)
+
+// A two-dimensional array, essentially. A bit easier to use than manually
+// calculating array positions.
+template <class T> using Buffer2D = PixelBuffer<T>;
+
+// Fill the two plasma lookup tables, each (2 * lookup_quant) times the canvas
+// size: rings around the center, and a warped grid. The terms that depend
+// only on x or only on y are worked out once per column or row, and the rest
+// a row at a time with the batch functions from fast-trig.h.
+inline void initPlasmaTables(Buffer2D<Q16_16> &plasma1, Buffer2D<Q16_16> &plasma2,
+                             int lookup_quant) {
+
+    const int width = plasma1.width(), height = plasma1.height();
+    const int center_x = width / 2;  // For our circular calcs.
+    const int center_y = height / 2;
+    std::vector<float> dx(width), warp_x(width);
+    for (int x=0; x < width; x++) {
+        dx[x] = center_x - x;
+        warp_x[x] = 1.0f / (31.0f + 11.0f * fastSinf(x / (14.25f * lookup_quant)));
+    }
+
+    parallelForTiles(1, height, KERNEL_TILE, [&](const Tile &t) {
+        std::vector<float> a(width), b(width);
+        for (int y=t.y0; y < t.y1; y++) {
+            // sin(sqrt((center_y-y)^2 + (center_x-x)^2) / (4 * lookup_quant))
+            fastHypotBatch(dx.data(), center_y - y, a.data(), width);
+            for (int x=0; x < width; x++) { a[x] *= 1.0f / (4 * lookup_quant); }
+            fastSinBatch(a.data(), a.data(), width);
+            for (int x=0; x < width; x++) { plasma1.At(x, y) = Q16_16::fromFloat(a[x]); }
+
+            // sin((4x / lookup_quant) / (37 + 15 cos(y / (18.5 lookup_quant))))
+            //   * cos((4y / lookup_quant) / (31 + 11 sin(x / (14.25 lookup_quant))))
+            const float warp_y = 1.0f / (37.0f + 15.0f * fastCosf(y / (18.5f * lookup_quant)));
+            const float fy = 4.0f * y / lookup_quant;
+            for (int x=0; x < width; x++) {
+                a[x] = (4.0f * x / lookup_quant) * warp_y;
+                b[x] = fy * warp_x[x];
+            }
+            fastSinBatch(a.data(), a.data(), width);
+            fastCosBatch(b.data(), b.data(), width);
+            for (int x=0; x < width; x++) { plasma2.At(x, y) = Q16_16::fromFloat(a[x] * b[x]); }
+        }
+    });
+}
+
+// Sum three windows of the plasma lookup tables into pixels, in Q16.16.
+// Keeps track of the range seen so far in lowest/highest.
+inline void samplePlasma(const Buffer2D<Q16_16> &plasma1, const Buffer2D<Q16_16> &plasma2,
+                         int x1, int y1, int x2, int y2, int x3, int y3, int lookup_quant,
+                         Buffer2D<Q16_16> &pixels, Q16_16 *lowest, Q16_16 *highest) {
+
+    // each tile keeps its own range, merged afterwards
+    const int tiles = tileCount(pixels.width(), pixels.height(), KERNEL_TILE);
+    std::vector<Q16_16> tile_lowest(tiles, *lowest), tile_highest(tiles, *highest);
+
+    parallelForTiles(pixels.width(), pixels.height(), KERNEL_TILE, [&](const Tile &t) {
+        Q16_16 lowest_value = tile_lowest[t.index];
+        Q16_16 highest_value = tile_highest[t.index];
+        for (int y=t.y0; y < t.y1; y++) {
+            for (int x=t.x0; x < t.x1; x++) {
+                // the tables hold [-1..1], so the plain sum can't overflow
+                Q16_16 value;
+                value.raw = plasma1.At(x1+lookup_quant*x, y1+lookup_quant*y).raw
+                          + plasma2.At(x2+lookup_quant*x, y2+lookup_quant*y).raw
+                          + plasma2.At(x3+lookup_quant*x, y3+lookup_quant*y).raw;
+                if (value < lowest_value) lowest_value = value;
+                if (value > highest_value) highest_value = value;
+                pixels.At(x, y) = value;
+            }
+        }
+        tile_lowest[t.index] = lowest_value;
+        tile_highest[t.index] = highest_value;
+    });
+
+    for (int i=0; i < tiles; i++) {
+        if (tile_lowest[i] < *lowest) *lowest = tile_lowest[i];
+        if (tile_highest[i] > *highest) *highest = tile_highest[i];
+    }
+}
+
+// Normalize the Q16.16 plasma to [0..255] palette indices. One divide per
+// frame for the scale, then a multiply per pixel.
+inline void normalizePlasma(const Buffer2D<Q16_16> &pixels, Q16_16 lowest, Q16_16 highest,
+                            uint8_t indices[]) {
+
+    const Q16_16 value_range = highest - lowest;
+    const Q16_16 scale = (value_range > Q16_16())
+        ? Q16_16::fromInt(255) / value_range : Q16_16();
+    const int width = pixels.width();
+    parallelForTiles(pixels.width(), pixels.height(), KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            for (int x=t.x0; x < t.x1; x++) {
+                indices[y * width + x] = ((pixels.At(x, y) - lowest) * scale).round();
+            }
+        }
+    });
+}
+
+// Anti-alias by down-sampling (averaging) 2x2 palette colors to 1.
+// pixels is (width * 2) x (height * 2).
+inline void downsample2x2(const uint8_t pixels[], const Color palette[], int width, int height,
+                          Color out[]) {
+
+    const int dwidth = width * 2;
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            int src = y * dwidth * 2 + t.x0 * 2;   // every other row
+            int dst = y * width + t.x0;
+            for (int x=t.x0; x < t.x1; x++) {
+                const Color &c0 = palette[pixels[src]],          &c1 = palette[pixels[src + 1]];
+                const Color &c2 = palette[pixels[src + dwidth]], &c3 = palette[pixels[src + dwidth + 1]];
+                out[dst].r = (c0.r + c1.r + c2.r + c3.r) >> 2;
+                out[dst].g = (c0.g + c1.g + c2.g + c3.g) >> 2;
+                out[dst].b = (c0.b + c1.b + c2.b + c3.b) >> 2;
+                dst++; src += 2;
+            }
+        }
+    });
+}
+
+// Anti-alias by down-sampling (averaging) 4x4 palette colors to 1.
+// pixels is (width * 4) x (height * 4).
+inline void downsample4x4(const uint8_t pixels[], const Color palette[], int width, int height,
+                          Color out[]) {
+
+    const int dwidth = width * 4;
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            // NOTE: advances 3 source rows per output row, as plasma2 always has.
+            int src = y * dwidth * 3 + t.x0 * 4;
+            int dst = y * width + t.x0;
+            for (int x=t.x0; x < t.x1; x++) {
+                int r = 0, g = 0, b = 0;
+                for (int sy=0; sy < 4; sy++) {
+                    const uint8_t *row = pixels + src + (dwidth * sy);
+                    for (int sx=0; sx < 4; sx++) {
+                        const Color &c = palette[row[sx]];
+                        r += c.r; g += c.g; b += c.b;
+                    }
+                }
+                out[dst].r = r >> 4;
+                out[dst].g = g >> 4;
+                out[dst].b = b >> 4;
+                dst++; src += 4;
+            }
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------
+// Xiaolin Wu's anti-aliased line algorithm (lines)
+// http://rosettacode.org/wiki/Xiaolin_Wu%27s_line_algorithm#C
+//
+// In Q16.16 fixed point. The end points are whole pixels, so each end is drawn
+// at half brightness with nothing below it, and only the position along the
+// line needs a fraction.
+
+#define swap_(a, b) do{ __typeof__(a) tmp; tmp = a; a = b; b = tmp; }while(0)
+
+// color * weight, for weight in [0..1]; can't overflow, so no saturation.
+inline Color scaleColor(const Color &color, Q16_16 weight) {
+    return Color((color.r * weight.raw) >> Q16_16::kFracBits,
+                 (color.g * weight.raw) >> Q16_16::kFracBits,
+                 (color.b * weight.raw) >> Q16_16::kFracBits);
+}
+
+// num / den for den > 0, rounded up, so that stepping by it lands exactly on
+// the whole pixels the line passes through (for lines under 256 pixels) and
+// the pixels match the double version.
+inline Q16_16 lineGradient(int num, int den) {
+    const int64_t n = (int64_t)num << Q16_16::kFracBits;
+    return Q16_16::fromRaw((n >= 0) ? (n + den - 1) / den : n / den);
+}
+
+// Canvas is anything with SetPixel(int x, int y, const Color &), such as
+// UDPFlaschenTaschen.
+template <class Canvas>
+void drawLine2(int x1, int y1, int x2, int y2, const Color &color, Canvas &canvas) {
+
+  const Q16_16 one = Q16_16::fromInt(1);
+  const Color end_color = scaleColor(color, Q16_16::ratio(1, 2));
+  const Color none = scaleColor(color, Q16_16());
+  const int dx = x2 - x1;
+  const int dy = y2 - y1;
+  if ( abs(dx) > abs(dy) ) {
+    if ( x2 < x1 ) {
+      swap_(x1, x2);
+      swap_(y1, y2);
+    }
+    const Q16_16 gradient = lineGradient(dy, dx);
+    canvas.SetPixel(x1, y1, end_color);
+    canvas.SetPixel(x1, y1 + 1, none);
+    canvas.SetPixel(x2, y2, end_color);
+    canvas.SetPixel(x2, y2 + 1, none);
+
+    Q16_16 intery = Q16_16::fromInt(y1) + gradient;
+    for (int x = x1 + 1; x <= (x2 - 1); x++) {
+      const Q16_16 f = intery.frac();
+      canvas.SetPixel(x, intery.floor(), scaleColor(color, one - f));
+      canvas.SetPixel(x, intery.floor() + 1, scaleColor(color, f));
+      intery += gradient;
+    }
+  } else {
+    if ( y2 < y1 ) {
+      swap_(x1, x2);
+      swap_(y1, y2);
+    }
+    const Q16_16 gradient = (dy != 0) ? lineGradient(dx, dy) : Q16_16();
+    canvas.SetPixel(x1, y1, end_color);
+    canvas.SetPixel(x1, y1 + 1, none);
+    canvas.SetPixel(x2, y2, end_color);
+    canvas.SetPixel(x2, y2 + 1, none);
+
+    Q16_16 interx = Q16_16::fromInt(x1) + gradient;
+    for (int y = y1 + 1; y <= (y2 - 1); y++) {
+      const Q16_16 f = interx.frac();
+      canvas.SetPixel(interx.floor(), y, scaleColor(color, one - f));
+      canvas.SetPixel(interx.floor() + 1, y, scaleColor(color, f));
+      interx += gradient;
+    }
+  }
+}
+
+// ------------------------------------------------------------------------------------------
+// Pixel copy
+
+// Copy an indexed pixel buffer to the canvas through the palette.
+template <class Canvas>
+void copyPalettePixels(const uint8_t pixels[], const Color palette[], int width, int height,
+                       Canvas &canvas) {
+
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            int dst = y * width + t.x0;
+            for (int x=t.x0; x < t.x1; x++) {
+                canvas.SetPixel( x, y, palette[ pixels[dst] ] );
+                dst++;
+            }
+        }
+    });
+}
+
+// Copy a color pixel buffer to the canvas as it is.
+template <class Canvas>
+void copyColorPixels(const Color pixels[], int width, int height, Canvas &canvas) {
+
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            const Color *row = pixels + y * width;
+            for (int x=t.x0; x < t.x1; x++) {
+                canvas.SetPixel( x, y, row[x] );
+            }
+        }
+    });
+}
+
+// The same into a render surface (a DemoCanvas' surface()), a row of a tile
+// at a time without the call per pixel.
+inline void copyPalettePixels(const uint8_t pixels[], const Color palette[], int width, int height,
+                              Surface &surface) {
+
+    Rgbx palette32[256];
+    paletteRgbx(palette, palette32);
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            blitPalette(pixels + y * width + t.x0, palette32, surface.Row(y) + t.x0, t.x1 - t.x0);
+        }
+    });
+}
+
+inline void copyColorPixels(const Color pixels[], int width, int height, Surface &surface) {
+
+    parallelForTiles(width, height, KERNEL_TILE, [&](const Tile &t) {
+        for (int y=t.y0; y < t.y1; y++) {
+            blitColors(pixels + y * width + t.x0, surface.Row(y) + t.x0, t.x1 - t.x0);
+        }
+    });
+}
+
+#endif  // DEMO_KERNELS_H
@@ -0,0 +1,1540 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// demo-runtime
+// Copyright (c) 2016-2020 Carl Gorringe (carl.gorringe.org)
+// https://github.com/cgorringe/ft-demos
+//
+// Modified Version 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Added a seedable random generator, a virtual clock and a
+// per-frame hash stream so two runs of a demo can be compared frame by frame.
+// 18/10/2026 - Added --record to save the frames sent as a clip file.
+// 18/10/2026 - Added --threads for the render thread pool.
+// 18/10/2026 - Added --pipeline to send frames from a separate thread.
+// 18/10/2026 - Added color correction (--gamma, --brightness, --white-balance,
+// --max-current) applied to every frame sent.
+// 18/10/2026 - Added --dither for temporal dithering of the output.
+// 18/10/2026 - Added --fade-in and --fade-out for every demo.
+// 18/10/2026 - Added the panel remap options (--rotate, --mirror, --panels,
+// --serpentine).
+// 18/10/2026 - Added the frame governor (--governor, --quality).
+// 18/10/2026 - Added frame interpolation (--interpolate).
+// 18/10/2026 - Frames too big for one UDP packet, e.g. long strips, are split
+// into several (--packet-size).
+// 18/10/2026 - Added the control channel (--control) and config reload on
+// SIGHUP (--config).
+// 18/10/2026 - Added the post-processing effect stack (--effects, effects.h).
+// 18/10/2026 - Added real-time scheduling, CPU pinning and the jitter report
+// (--realtime, --cpus, --send-cpus, --jitter, realtime.h).
+// 18/10/2026 - DemoCanvas draws into an RGBX surface (surface.h), packed into
+// the transmit buffer once per frame by Send().
+// 18/10/2026 - Added the animation clock (demoTime(), demoDelta(), demoSteps());
+// demoSleep() keeps frames on a fixed schedule and skips the ones it is late for.
+//
+// Runtime shared by all the demos. It provides the common long options,
+// the demo clock used in place of time(), difftime() and usleep(), and
+// DemoCanvas, a UDPFlaschenTaschen that can record what it sends and pass it
+// through the output stages (interpolation, color correction, dithering, fades,
+// remap). Its pixels live in a Surface of 32 bit RGBX pixels, which demos
+// may also draw into directly through surface().
+//
+// Replay mode:
+//
+//  ./life --seed 42 --fixed-clock --hash life.hash -t 60
+//
+// runs the demo as fast as it can on a virtual clock that only advances by
+// the frame delays, and writes one line per frame sent:
+//
+//  <frame number> <fnv-1a 64 bit hash of offset and pixels>
+//
+// Two such streams are compared with the replay-check tool.
+//
+// Recording:
+//
+//  ./fractal --fixed-clock -t 300 --record fractal.ftc
+//
+// pre-renders the demo into a clip file (see clip-format.h) that
+// clip-player streams to the display at the recorded pace.
+//
+// Pipeline mode:
+//
+//  ./plasma --pipeline 4
+//
+// renders up to 4 frames ahead of the display. Send() queues a copy of the
+// canvas and a sender thread transmits it when it is due, so a frame that
+// takes longer to render than usual doesn't show as a stutter. Interactive
+// demos should stay at 1 frame ahead, or not use it at all.
+//
+// Frame governor:
+//
+//  ./fractal --governor
+//
+// measures how long each frame takes to render against the frame delay given
+// to demoSleep(). A demo that registers its quality settings (DemoQuality)
+// is stepped down a level when it keeps missing the budget, and back up
+// after a while with time to spare. --quality <n> fixes the level instead,
+// which also works with --fixed-clock, where the governor is off.
+//
+// Animation clock:
+//
+//  int steps = 1;
+//  do {
+//      for (int s=0; s < steps; s++) { stepAnimation(); }
+//      drawFrame(canvas);
+//      canvas.Send();
+//      demoSleep(opt_delay);
+//      steps = demoSteps(demoFrameDelay(opt_delay));
+//  } while (...);
+//
+// Demos animate by time rather than by frames rendered. demoSteps() gives
+// the fixed steps of animation due since the last frame, and demoTime() and
+// demoDelta() the time of the frame and since the one before, for motion
+// that isn't stepped. A delay set through the control channel changes the
+// step length with the frame rate, so it still sets the animation speed.
+// Frames are due a delay apart from demoStart(); when
+// one takes so long that the next is more than a delay late, demoSleep()
+// doesn't wait, skips the frames missed and the animation jumps ahead by
+// them, so it keeps its speed on an overloaded host. The same goes for
+// --pipeline, where the sender thread does the waiting. With --fixed-clock
+// every frame is on time, one step after the one before.
+//
+// Frame interpolation:
+//
+//  ./plasma --interpolate 2
+//
+// renders every other frame only. Demos that support it call
+// demoInterpolate() and advance their animation by the step it returns, or
+// by demoSteps(), which counts the frames in between too. Send() then sends
+// the frames in between, blended from the last frame rendered and the new
+// one, one frame delay apart. This delays the display by a rendered frame,
+// so it is for demos that don't react to input.
+//
+// Packets:
+//
+//  ./life -g 30000x1 --packet-size 1472
+//
+// A frame bigger than the packet size is sent as several packets, each a band
+// of whole rows or, for rows that don't fit (long strips), a run of one row,
+// at its own offset. The parts are as even as possible. The default is the
+// largest UDP packet; the size of an Ethernet frame's payload, 1472, avoids IP
+// fragmentation on lossy links.
+//
+// Control channel:
+//
+//  ./plasma --control 7001 --config plasma.conf
+//  echo "delay 40" | nc -u -w1 127.0.0.1 7001
+//
+// takes commands on a UDP port of the local host, one per line, and applies
+// them between frames:
+//
+//  delay <msec>        frame delay, 0 = the demo's own
+//  layer <n>           layer 0-15, -1 = the demo's own
+//  offset <dx> <dy>    moves the output from the demo's offset
+//  brightness <b>      output brightness 0.0 to 1.0
+//  pause, resume       holds the last frame; the demo clock stops too
+//  stats               frames, frame rate, the settings below
+//  effects <spec>      the effect stack, for demos that use one
+//  <name> <value>      a setting the demo registered with demoControl(),
+//                      e.g. palette
+//
+// Each command is answered with "ok", "error ..." or the stats. The config
+// file holds the same commands (# starts a comment); it is applied at
+// demoStart() and again whenever the demo gets a SIGHUP.
+//
+// Real time:
+//
+//  ./plasma --realtime fifo:60 --cpus 2-3 --pipeline 2 --send-cpus 1 --jitter
+//
+// runs the render threads (the demo's and the thread pool's) with SCHED_FIFO
+// priority 60 on CPUs 2 and 3, and the pipeline's sender one priority higher
+// on CPU 1, with all memory locked (see realtime.h). FT_REALTIME gives the
+// policy when --realtime doesn't, e.g. for every demo a playlist starts.
+// --jitter prints at exit how late the frames were sent against their due
+// times.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef DEMO_RUNTIME_H
+#define DEMO_RUNTIME_H
+
+#include "udp-flaschen-taschen.h"
+#include "clip-format.h"
+#include "output-stage.h"
+#include "thread-pool.h"
+#include "effects.h"
+#include "realtime.h"
+#include "surface.h"
+#include "frame-packets.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DEMO_PIPELINE_MAX 16
+#define DEMO_INTERPOLATE_MAX 3
+#define DEMO_CONTROL_PARAMS 16      // settings a demo can register
+#define DEMO_CONTROL_POLL 100       // msec between checks while paused
+#define DEMO_STEPS_MAX 8            // animation steps caught up in one frame
+
+#define GOVERNOR_HIGH 0.9           // step down above this share of the frame delay
+#define GOVERNOR_LOW 0.4            // step up below it
+#define GOVERNOR_SMOOTHING 8        // frames averaged
+#define GOVERNOR_DEGRADE_FRAMES 8   // frames over budget before stepping down
+#define GOVERNOR_RECOVER_FRAMES 120 // frames with headroom before stepping up
+#define GOVERNOR_BACKOFF_MAX 32     // longest recovery wait, in GOVERNOR_RECOVER_FRAMES
+
+// ------------------------------------------------------------------------------------------
+// Common Command Line Options
+
+// Long options accepted by every demo. Values start above the range of the
+// single character options so they can share the switch in cmdLine().
+enum {
+    OPT_SEED = 0x100,
+    OPT_FIXED_CLOCK,
+    OPT_HASH,
+    OPT_DUMP_FRAMES,
+    OPT_RECORD,
+    OPT_THREADS,
+    OPT_PIPELINE,
+    OPT_GAMMA,
+    OPT_BRIGHTNESS,
+    OPT_WHITE_BALANCE,
+    OPT_MAX_CURRENT,
+    OPT_DITHER,
+    OPT_FADE_IN,
+    OPT_FADE_OUT,
+    OPT_ROTATE,
+    OPT_MIRROR,
+    OPT_PANELS,
+    OPT_SERPENTINE,
+    OPT_GOVERNOR,
+    OPT_QUALITY,
+    OPT_INTERPOLATE,
+    OPT_PACKET_SIZE,
+    OPT_CONTROL,
+    OPT_CONFIG,
+    OPT_EFFECTS,
+    OPT_REALTIME,
+    OPT_CPUS,
+    OPT_SEND_CPUS,
+    OPT_JITTER,
+};
+
+static const struct option demo_long_options[] = {
+    { "seed",        required_argument, NULL, OPT_SEED },
+    { "fixed-clock", no_argument,       NULL, OPT_FIXED_CLOCK },
+    { "hash",        required_argument, NULL, OPT_HASH },
+    { "dump-frames", required_argument, NULL, OPT_DUMP_FRAMES },
+    { "record",      required_argument, NULL, OPT_RECORD },
+    { "threads",     required_argument, NULL, OPT_THREADS },
+    { "pipeline",    required_argument, NULL, OPT_PIPELINE },
+    { "gamma",       required_argument, NULL, OPT_GAMMA },
+    { "brightness",  required_argument, NULL, OPT_BRIGHTNESS },
+    { "white-balance", required_argument, NULL, OPT_WHITE_BALANCE },
+    { "max-current", required_argument, NULL, OPT_MAX_CURRENT },
+    { "dither",      no_argument,       NULL, OPT_DITHER },
+    { "fade-in",     required_argument, NULL, OPT_FADE_IN },
+    { "fade-out",    required_argument, NULL, OPT_FADE_OUT },
+    { "rotate",      required_argument, NULL, OPT_ROTATE },
+    { "mirror",      required_argument, NULL, OPT_MIRROR },
+    { "panels",      required_argument, NULL, OPT_PANELS },
+    { "serpentine",  no_argument,       NULL, OPT_SERPENTINE },
+    { "governor",    no_argument,       NULL, OPT_GOVERNOR },
+    { "quality",     required_argument, NULL, OPT_QUALITY },
+    { "interpolate", required_argument, NULL, OPT_INTERPOLATE },
+    { "packet-size", required_argument, NULL, OPT_PACKET_SIZE },
+    { "control",     required_argument, NULL, OPT_CONTROL },
+    { "config",      required_argument, NULL, OPT_CONFIG },
+    { "effects",     required_argument, NULL, OPT_EFFECTS },
+    { "realtime",    required_argument, NULL, OPT_REALTIME },
+    { "cpus",        required_argument, NULL, OPT_CPUS },
+    { "send-cpus",   required_argument, NULL, OPT_SEND_CPUS },
+    { "jitter",      no_argument,       NULL, OPT_JITTER },
+    { NULL, 0, NULL, 0 }
+};
+
+struct DemoOptions {
+    bool seed_set = false;
+    unsigned int seed = 0;
+    bool fixed_clock = false;
+    const char *hash_file = NULL;   // "-" writes to stdout
+    const char *frame_dir = NULL;
+    const char *clip_file = NULL;
+    int pipeline = 0;               // frames queued ahead of the sender, 0 = off
+    ColorCorrection color;
+    bool dither = false;
+    double fade_in = 0;             // seconds
+    double fade_out = 0;            // seconds before timeout
+    double timeout = -1;            // end of the fade out, see demoSetTimeout()
+    OutputRemap remap;
+    bool governor = false;
+    int quality = -1;               // fixed quality level, -1 = best or governed
+    int interpolate = 1;            // frames sent per frame rendered
+    int packet_size = FRAME_PACKET_MAX;  // bytes
+    int control_port = 0;           // UDP port for control commands, 0 = off
+    const char *config_file = NULL; // control commands applied at start and on SIGHUP
+    const char *effects = NULL;     // effect stack, replaces the demo's own
+    const char *realtime = NULL;    // scheduling policy, NULL = FT_REALTIME
+    std::vector<int> cpus;          // render threads' CPUs, empty = any
+    std::vector<int> send_cpus;     // sender thread's CPUs, empty = as the demo's
+    bool jitter = false;
+};
+
+inline DemoOptions demo_opts;
+
+inline void demoUsage() {
+    fprintf(stderr, "Common options:\n"
+        "\t--seed <n>     : Seed the random generator. (default time)\n"
+        "\t--fixed-clock  : Run on a virtual clock advanced only by frame delays.\n"
+        "\t--hash <file>  : Write a hash of every frame sent to file (- = stdout).\n"
+        "\t--dump-frames <dir> : Write every frame sent to dir as a PPM image.\n"
+        "\t--record <file> : Record every frame sent to a clip for clip-player.\n"
+        "\t--threads <n>  : Render threads. (FT_THREADS, default all CPUs)\n"
+        "\t--pipeline <n> : Render up to n frames ahead of a sender thread. (1-16)\n"
+        "\t--gamma <g>    : Gamma correction of the LEDs, e.g. 2.2. (default 1.0)\n"
+        "\t--brightness <b> : Output brightness 0.0 to 1.0. (default 1.0)\n"
+        "\t--white-balance <r>,<g>,<b> : Channel levels 0.0 to 1.0. (default 1,1,1)\n"
+        "\t--max-current <percent> : Limit every channel to percent of full on. (default 100)\n"
+        "\t--dither       : Temporal dithering for smooth dark levels and fades.\n"
+        "\t--fade-in <s>  : Fade in over the first s seconds.\n"
+        "\t--fade-out <s> : Fade out over the last s seconds before the timeout.\n"
+        "\t--rotate <deg> : Rotate the output clockwise by 0, 90, 180 or 270.\n"
+        "\t--mirror <x|y|xy> : Mirror the output (after rotating).\n"
+        "\t--panels <W>x<H> : Cut the output into a chain of WxH panels.\n"
+        "\t--serpentine   : Reverse every other output row.\n"
+        "\t--governor     : Lower the render quality when frames run late.\n"
+        "\t--quality <n>  : Fixed render quality level, 0 = best. (default 0)\n"
+        "\t--interpolate <n> : Render every n-th frame, blend the others. (1-3, default 1)\n"
+        "\t--packet-size <bytes> : Split bigger frames into several packets. (default 65507)\n"
+        "\t--control <port> : Take control commands on this UDP port of localhost.\n"
+        "\t--config <file> : Apply control commands from file, again on SIGHUP.\n"
+        "\t--effects <list> : Post-processing effects, e.g. blur,decay:32 (see effects.h).\n"
+        "\t--realtime <fifo|rr|off>[:<prio>] : Real-time scheduling, memory locked. (FT_REALTIME)\n"
+        "\t--cpus <list> : Pin the render threads to CPUs, e.g. 2-3.\n"
+        "\t--send-cpus <list> : Pin the --pipeline sender thread to CPUs.\n"
+        "\t--jitter      : Print how late frames were at exit.\n"
+    );
+}
+
+// Handles one of the common long options from getopt_long().
+// Returns false if the option is unknown or its argument is invalid.
+inline bool demoOption(int opt, const char *arg) {
+    switch (opt) {
+    case OPT_SEED:
+        if (sscanf(arg, "%u", &demo_opts.seed) != 1) {
+            fprintf(stderr, "Invalid seed '%s'\n", arg);
+            return false;
+        }
+        demo_opts.seed_set = true;
+        return true;
+    case OPT_FIXED_CLOCK:
+        demo_opts.fixed_clock = true;
+        return true;
+    case OPT_HASH:
+        demo_opts.hash_file = arg;
+        return true;
+    case OPT_DUMP_FRAMES:
+        demo_opts.frame_dir = arg;
+        return true;
+    case OPT_RECORD:
+        demo_opts.clip_file = arg;
+        return true;
+    case OPT_THREADS:
+        if (sscanf(arg, "%d", &thread_pool_threads) != 1 || thread_pool_threads < 1) {
+            fprintf(stderr, "Invalid threads '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_PIPELINE:
+        if (sscanf(arg, "%d", &demo_opts.pipeline) != 1 || demo_opts.pipeline < 1
+            || demo_opts.pipeline > DEMO_PIPELINE_MAX) {
+            fprintf(stderr, "Invalid pipeline '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_GAMMA:
+        if (sscanf(arg, "%f", &demo_opts.color.gamma) != 1 || demo_opts.color.gamma <= 0) {
+            fprintf(stderr, "Invalid gamma '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_BRIGHTNESS:
+        if (sscanf(arg, "%f", &demo_opts.color.brightness) != 1
+            || demo_opts.color.brightness < 0 || demo_opts.color.brightness > 1.0) {
+            fprintf(stderr, "Invalid brightness '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_WHITE_BALANCE: {
+        float *w = demo_opts.color.white;
+        if (sscanf(arg, "%f,%f,%f", &w[0], &w[1], &w[2]) != 3
+            || w[0] < 0 || w[0] > 1.0 || w[1] < 0 || w[1] > 1.0 || w[2] < 0 || w[2] > 1.0) {
+            fprintf(stderr, "Invalid white balance '%s'\n", arg);
+            return false;
+        }
+        return true;
+    }
+    case OPT_MAX_CURRENT: {
+        int percent;
+        if (sscanf(arg, "%d", &percent) != 1 || percent < 1 || percent > 100) {
+            fprintf(stderr, "Invalid max current '%s'\n", arg);
+            return false;
+        }
+        demo_opts.color.max_level = percent / 100.0f;
+        return true;
+    }
+    case OPT_DITHER:
+        demo_opts.dither = true;
+        return true;
+    case OPT_FADE_IN:
+        if (sscanf(arg, "%lf", &demo_opts.fade_in) != 1 || demo_opts.fade_in < 0) {
+            fprintf(stderr, "Invalid fade in '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_FADE_OUT:
+        if (sscanf(arg, "%lf", &demo_opts.fade_out) != 1 || demo_opts.fade_out < 0) {
+            fprintf(stderr, "Invalid fade out '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_ROTATE: {
+        int deg;
+        if (sscanf(arg, "%d", &deg) != 1 || deg < 0 || deg > 270 || (deg % 90) != 0) {
+            fprintf(stderr, "Invalid rotation '%s'\n", arg);
+            return false;
+        }
+        demo_opts.remap.rotate = deg;
+        return true;
+    }
+    case OPT_MIRROR:
+        demo_opts.remap.mirror_x = (strchr(arg, 'x') != NULL);
+        demo_opts.remap.mirror_y = (strchr(arg, 'y') != NULL);
+        if (strspn(arg, "xy") != strlen(arg) || !*arg) {
+            fprintf(stderr, "Invalid mirror '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_PANELS:
+        if (sscanf(arg, "%dx%d", &demo_opts.remap.panel_width, &demo_opts.remap.panel_height) != 2
+            || demo_opts.remap.panel_width < 1 || demo_opts.remap.panel_height < 1) {
+            fprintf(stderr, "Invalid panel size '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_SERPENTINE:
+        demo_opts.remap.serpentine = true;
+        return true;
+    case OPT_GOVERNOR:
+        demo_opts.governor = true;
+        return true;
+    case OPT_QUALITY:
+        if (sscanf(arg, "%d", &demo_opts.quality) != 1 || demo_opts.quality < 0) {
+            fprintf(stderr, "Invalid quality '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_INTERPOLATE:
+        if (sscanf(arg, "%d", &demo_opts.interpolate) != 1 || demo_opts.interpolate < 1
+            || demo_opts.interpolate > DEMO_INTERPOLATE_MAX) {
+            fprintf(stderr, "Invalid interpolate '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_PACKET_SIZE:
+        if (sscanf(arg, "%d", &demo_opts.packet_size) != 1 || demo_opts.packet_size < FRAME_PACKET_MIN
+            || demo_opts.packet_size > FRAME_PACKET_MAX) {
+            fprintf(stderr, "Invalid packet size '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_CONTROL:
+        if (sscanf(arg, "%d", &demo_opts.control_port) != 1 || demo_opts.control_port < 1
+            || demo_opts.control_port > 65535) {
+            fprintf(stderr, "Invalid control port '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_CONFIG:
+        demo_opts.config_file = arg;
+        return true;
+    case OPT_EFFECTS: {
+        EffectStack check;
+        std::string error;
+        if (!check.Parse(arg, &error)) {
+            fprintf(stderr, "Invalid effects: %s\n", error.c_str());
+            return false;
+        }
+        demo_opts.effects = arg;
+        return true;
+    }
+    case OPT_REALTIME: {
+        int policy, priority;
+        if (!realtimeParsePolicy(arg, &policy, &priority)) {
+            fprintf(stderr, "Invalid realtime '%s'\n", arg);
+            return false;
+        }
+        demo_opts.realtime = arg;
+        return true;
+    }
+    case OPT_CPUS:
+        if (!realtimeParseCpus(arg, &demo_opts.cpus)) {
+            fprintf(stderr, "Invalid CPU list '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_SEND_CPUS:
+        if (!realtimeParseCpus(arg, &demo_opts.send_cpus)) {
+            fprintf(stderr, "Invalid CPU list '%s'\n", arg);
+            return false;
+        }
+        return true;
+    case OPT_JITTER:
+        demo_opts.jitter = true;
+        return true;
+    }
+    return false;
+}
+
+// Command line of the simple demos that only take the hostname as their
+// first argument. Returns false after printing usage on a bad option.
+inline bool demoSimpleCmdLine(int argc, char *argv[], const char **hostname) {
+    int opt;
+    while ((opt = getopt_long(argc, argv, "?", demo_long_options, NULL)) != -1) {
+        if (opt == '?' || !demoOption(opt, optarg)) {
+            fprintf(stderr, "Usage: %s [options] [host]\n", argv[0]);
+            demoUsage();
+            return false;
+        }
+    }
+    *hostname = (optind < argc) ? argv[optind] : NULL;
+    return true;
+}
+
+// Tells the runtime when the demo will end, for --fade-out.
+inline void demoSetTimeout(double seconds) {
+    demo_opts.timeout = seconds;
+}
+
+// Seed for srandom(), either from --seed or the wall clock.
+inline unsigned int demoSeed() {
+    return demo_opts.seed_set ? demo_opts.seed : (unsigned int)time(NULL);
+}
+
+// ------------------------------------------------------------------------------------------
+// Demo Clock
+
+inline double monotonicSeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+struct DemoClock {
+    DemoClock() { clock_gettime(CLOCK_MONOTONIC, &start); }
+    struct timespec start;
+    double virtual_time = 0;    // seconds, used with --fixed-clock and --pipeline
+    bool frame_queued = false;  // a frame went to the pipeline since the last sleep
+    int frame_step = 1;         // frames sent per frame rendered, see demoInterpolate()
+    int frame_delay = 0;        // msec, of the last demoSleep()
+    double frame_time = 0;      // seconds, see demoTime()
+    double frame_dt = 0;        // seconds, see demoDelta()
+    double due = 0;             // seconds, when the last frame was due
+    double stepped = 0;         // seconds of animation demoSteps() has given out
+    int step_msec = 0;          // step length of the last demoSteps()
+    long skipped = 0;           // frames given up for being late
+    // with --pipeline: monotonic seconds at demo time 0, -1 until the first
+    // frame is queued; set by the demo's thread, read by the sender
+    std::atomic<double> base{-1};
+};
+
+inline DemoClock demo_clock;
+
+inline void demoControlStart();
+inline void demoRealtimeStart();
+
+// Restart the clock. Call just before the main loop.
+inline void demoStart() {
+    demoRealtimeStart();
+    demoControlStart();
+    clock_gettime(CLOCK_MONOTONIC, &demo_clock.start);
+    demo_clock.virtual_time = 0;
+    demo_clock.frame_time = demo_clock.frame_dt = 0;
+    demo_clock.due = demo_clock.stepped = 0;
+    demo_clock.step_msec = 0;
+    demo_clock.base = monotonicSeconds();
+}
+
+// True if the demo runs on the virtual clock. In pipeline mode it is the time
+// the frame being rendered is due, ahead of the wall clock by the frames
+// queued, and the sender thread sends each frame at its time.
+inline bool demoVirtualClock() {
+    return demo_opts.fixed_clock || demo_opts.pipeline > 0;
+}
+
+// Seconds since demoStart().
+inline double demoElapsed() {
+    if (demoVirtualClock()) {
+        return demo_clock.virtual_time;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - demo_clock.start.tv_sec)
+        + (double)(now.tv_nsec - demo_clock.start.tv_nsec) / 1000000000.0;
+}
+
+// Seconds since demoStart() of the frame being rendered: the time the last
+// demoSleep() returned, so everything drawn in a frame sees the same time.
+inline double demoTime() {
+    return demo_clock.frame_time;
+}
+
+// Seconds between the frame being rendered and the one before.
+inline double demoDelta() {
+    return demo_clock.frame_dt;
+}
+
+// For demos that animate in fixed steps of msec: the steps that have passed
+// by demoTime() since the last call or demoStart(). After each demoSleep()
+// that is 1 while frames are on time, more when frames were skipped or
+// interpolated, and at times 0 when the frame rate is above the step rate.
+// At most DEMO_STEPS_MAX, so a demo that can't keep up falls behind instead
+// of taking ever longer to catch up. Pass the delay through demoFrameDelay(),
+// so the steps follow a delay set at runtime; when the step length changes,
+// the frame just shown counts as one step of the new length.
+inline int demoSteps(int msec) {
+    if (msec <= 0) return 1;
+    const double period = msec / 1000.0;
+    if (msec != demo_clock.step_msec) {
+        if (demo_clock.step_msec > 0) {
+            demo_clock.stepped = demo_clock.frame_time - period;
+        }
+        demo_clock.step_msec = msec;
+    }
+    const int n = (int)((demo_clock.frame_time - demo_clock.stepped) / period + 1e-6);  // clock rounding
+    if (n <= 0) return 0;
+    demo_clock.stepped += n * period;
+    return (n < DEMO_STEPS_MAX) ? n : DEMO_STEPS_MAX;
+}
+
+// Frames the demo should advance its animation by for every frame it renders,
+// from --interpolate. Calling it turns interpolation on, so only demos that
+// step their animation by it, or by demoSteps(), are interpolated.
+inline int demoInterpolate() {
+    demo_clock.frame_step = demo_opts.interpolate;
+    return demo_clock.frame_step;
+}
+
+// Advances the virtual clock only, for time spent blocking elsewhere
+// (e.g. waiting on input). Does nothing on the wall clock.
+inline void demoAdvance(int msec) {
+    if (demoVirtualClock()) {
+        demo_clock.virtual_time += msec / 1000.0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Frame Governor
+
+// Settings a demo can trade for render time. Level 0 is the best quality and
+// each level above it should be clearly cheaper than the one before.
+class DemoQuality {
+public:
+    virtual ~DemoQuality() {}
+    virtual int Levels() const = 0;
+    // Called between frames; the demo applies it from its next frame on.
+    virtual void SetLevel(int level) = 0;
+};
+
+struct DemoGovernor {
+    DemoQuality *quality = NULL;
+    int level = 0;
+    double render_start = 0;        // monotonic seconds, end of the last sleep
+    double render_end = -1;         // start of the last Send()
+    double load = -1;               // render time / frame delay, smoothed; -1 = restart
+    int over = 0, under = 0;        // consecutive frames above or below the limits
+    int frames = 0;                 // since the last change
+    int backoff = 1;                // recovery wait, in GOVERNOR_RECOVER_FRAMES
+    bool recovered = false;         // the last change was a step up
+};
+
+inline DemoGovernor demo_governor;
+
+inline bool demoGoverned() {
+    return demo_opts.governor && !demo_opts.fixed_clock && demo_opts.quality < 0
+        && demo_governor.quality;
+}
+
+// Registers the demo's quality settings and applies --quality, if given.
+inline void demoSetQuality(DemoQuality *quality) {
+    DemoGovernor &g = demo_governor;
+    g.quality = quality;
+    g.level = 0;
+    if (demo_opts.quality >= 0) {
+        g.level = (demo_opts.quality < quality->Levels()) ? demo_opts.quality : quality->Levels() - 1;
+    }
+    quality->SetLevel(g.level);
+}
+
+inline void demoSetQualityLevel(int level) {
+    DemoGovernor &g = demo_governor;
+    g.recovered = (level < g.level);
+    g.level = level;
+    g.quality->SetLevel(level);
+    g.load = -1;
+    g.over = g.under = g.frames = 0;
+}
+
+// Called at every frame wait with the time the frame took to render.
+inline void demoGovern(double render, int msec) {
+    DemoGovernor &g = demo_governor;
+    const double load = render * 1000.0 / msec;
+    g.load = (g.load < 0) ? load : g.load + (load - g.load) / GOVERNOR_SMOOTHING;
+    g.frames++;
+
+    g.over = (g.load > GOVERNOR_HIGH) ? g.over + 1 : 0;
+    g.under = (g.load < GOVERNOR_LOW) ? g.under + 1 : 0;
+    if (g.over >= GOVERNOR_DEGRADE_FRAMES && g.level < g.quality->Levels() - 1) {
+        // a step up that didn't hold waits longer before the next try
+        if (g.recovered && g.frames < GOVERNOR_RECOVER_FRAMES * g.backoff
+            && g.backoff < GOVERNOR_BACKOFF_MAX) {
+            g.backoff *= 2;
+        }
+        demoSetQualityLevel(g.level + 1);
+    }
+    else if (g.under >= GOVERNOR_RECOVER_FRAMES * g.backoff && g.level > 0) {
+        demoSetQualityLevel(g.level - 1);
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Real Time
+
+struct DemoRealtime {
+    bool started = false;
+    int policy = SCHED_OTHER;       // in effect, after any failure
+    int priority = 0;
+    JitterReport jitter;
+};
+
+inline DemoRealtime demo_realtime;
+
+inline void demoFlush();
+
+inline void demoJitterReport() {
+    demoFlush();
+    demo_realtime.jitter.Print(stderr, "frames");
+}
+
+// Applies --realtime (or FT_REALTIME) and --cpus to the demo's thread and
+// the thread pool, once.
+inline void demoRealtimeStart() {
+    DemoRealtime &r = demo_realtime;
+    if (r.started) return;
+    r.started = true;
+    const char *policy = demo_opts.realtime ? demo_opts.realtime : getenv("FT_REALTIME");
+    if (policy && !realtimeParsePolicy(policy, &r.policy, &r.priority)) {
+        fprintf(stderr, "Invalid FT_REALTIME '%s'\n", policy);
+    }
+    if (r.policy != SCHED_OTHER) {
+        realtimeLockMemory();
+    }
+    if (r.policy != SCHED_OTHER || !demo_opts.cpus.empty()) {
+        if (!realtimeSetThread(pthread_self(), r.policy, r.priority, demo_opts.cpus)) {
+            r.policy = SCHED_OTHER;
+        }
+        // the workers get one of the CPUs each, as the pool pins them
+        demoThreadPool().ForEachWorker([&r](pthread_t thread, int t) {
+            std::vector<int> cpu;
+            if (!demo_opts.cpus.empty()) {
+                cpu.push_back(demo_opts.cpus[t % demo_opts.cpus.size()]);
+            }
+            realtimeSetThread(thread, r.policy, r.priority, cpu);
+        });
+    }
+    if (demo_opts.jitter) {
+        atexit(demoJitterReport);
+    }
+}
+
+// Called by the sender thread: it runs a priority above the render threads,
+// as it has a deadline for every frame and they don't.
+inline void demoRealtimeSender() {
+    const DemoRealtime &r = demo_realtime;
+    const int max = sched_get_priority_max(SCHED_FIFO);
+    if (r.policy != SCHED_OTHER || !demo_opts.send_cpus.empty()) {
+        realtimeSetThread(pthread_self(), r.policy, (r.priority < max) ? r.priority + 1 : max,
+                          demo_opts.send_cpus);
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Effects
+
+struct DemoEffects {
+    bool used = false;              // the demo runs the stack, see demoEffects()
+    EffectStack stack;
+};
+
+inline DemoEffects demo_effects;
+
+// Gives the demo an effect stack (effects.h), spec unless --effects is given.
+// The control channel's "effects" command replaces it between frames. The
+// demo runs it over its buffer every frame with demoApplyEffects().
+inline void demoEffects(const char *spec) {
+    std::string error;
+    demo_effects.used = true;
+    if (!demo_effects.stack.Parse(demo_opts.effects ? demo_opts.effects : spec, &error)) {
+        fprintf(stderr, "Invalid effects: %s\n", error.c_str());
+    }
+}
+
+inline void demoApplyEffects(uint8_t pixels[], int width, int height) {
+    if (demo_effects.used) { demo_effects.stack.Apply(pixels, width, height); }
+}
+
+inline void demoApplyEffects(Color pixels[], int width, int height) {
+    if (demo_effects.used) { demo_effects.stack.Apply(pixels, width, height); }
+}
+
+inline void demoApplyEffects(Rgbx pixels[], int width, int height) {
+    if (demo_effects.used) { demo_effects.stack.Apply(pixels, width, height); }
+}
+
+// ------------------------------------------------------------------------------------------
+// Control Channel
+
+// A setting of the demo the control channel may change.
+struct DemoControlParam {
+    const char *name;
+    int *value;
+    int min, max;
+    int also;                       // one more valid value, e.g. -1 = cycle
+};
+
+struct DemoControl {
+    bool started = false;
+    int fd = -1;                    // UDP socket of --control
+    DemoControlParam params[DEMO_CONTROL_PARAMS];
+    int nparams = 0;
+    int delay = 0;                  // msec, replaces the demo's frame delay if > 0
+    int layer = -1;                 // replaces the demo's layer if >= 0
+    int dx = 0, dy = 0;             // added to the demo's offset
+    bool paused = false;
+    int color_version = 0;          // bumped when the color correction changes
+    long frames = 0;                // sent
+    long stats_frames = 0;          // frames and time of the last stats
+    double stats_time = 0;
+};
+
+inline DemoControl demo_control;
+inline volatile sig_atomic_t demo_reload = 0;
+
+inline void demoReloadHandler(int signo) {
+    demo_reload = 1;
+}
+
+// Lets the control channel set *value to min..max (or also). The demo keeps
+// reading it as before; changes land between frames.
+inline void demoControl(const char *name, int *value, int min, int max, int also = INT_MIN) {
+    if (demo_control.nparams < DEMO_CONTROL_PARAMS) {
+        demo_control.params[demo_control.nparams++] = { name, value, min, max, also };
+    }
+}
+
+// Runs one command (see the top of this file). Returns false on an error,
+// with the reply saying why.
+inline bool demoCommand(const char *line, char *reply, size_t len) {
+    DemoControl &c = demo_control;
+    char cmd[32];
+    int n = 0;
+    snprintf(reply, len, "ok");
+    if (sscanf(line, "%31s%n", cmd, &n) != 1 || cmd[0] == '#') {
+        reply[0] = '\0';
+        return true;
+    }
+    const char *arg = line + n;
+    int a, b;
+    float f;
+    if (strcmp(cmd, "delay") == 0) {
+        if (sscanf(arg, "%d", &a) != 1 || a < 0 || a > 60000) goto invalid;
+        c.delay = a;
+    }
+    else if (strcmp(cmd, "layer") == 0) {
+        if (sscanf(arg, "%d", &a) != 1 || a < -1 || a > 15) goto invalid;
+        c.layer = a;
+    }
+    else if (strcmp(cmd, "offset") == 0) {
+        if (sscanf(arg, "%d %d", &a, &b) != 2) goto invalid;
+        c.dx = a;
+        c.dy = b;
+    }
+    else if (strcmp(cmd, "brightness") == 0) {
+        if (sscanf(arg, "%f", &f) != 1 || f < 0 || f > 1.0) goto invalid;
+        demo_opts.color.brightness = f;
+        c.color_version++;
+    }
+    else if (strcmp(cmd, "pause") == 0) {
+        c.paused = true;
+    }
+    else if (strcmp(cmd, "resume") == 0) {
+        c.paused = false;
+    }
+    else if (strcmp(cmd, "effects") == 0 && demo_effects.used) {
+        char spec[256];
+        std::string error;
+        if (sscanf(arg, "%255s", spec) != 1 || !demo_effects.stack.Parse(spec, &error)) goto invalid;
+    }
+    else if (strcmp(cmd, "stats") == 0) {
+        const double now = monotonicSeconds();
+        const double fps = (c.stats_time > 0 && now > c.stats_time)
+            ? (c.frames - c.stats_frames) / (now - c.stats_time) : 0;
+        c.stats_frames = c.frames;
+        c.stats_time = now;
+        std::string s;
+        char buf[128];
+        snprintf(buf, sizeof(buf), "frames %ld fps %.1f elapsed %.1f delay %d layer %d offset %d %d"
+                 " brightness %.2f paused %d skipped %ld", c.frames, fps, demoElapsed(),
+                 demo_clock.frame_delay, c.layer, c.dx, c.dy, demo_opts.color.brightness, c.paused,
+                 demo_clock.skipped);
+        s = buf;
+        if (demo_governor.quality) {
+            snprintf(buf, sizeof(buf), " quality %d", demo_governor.level);
+            s += buf;
+        }
+        for (int i=0; i < c.nparams; i++) {
+            snprintf(buf, sizeof(buf), " %s %d", c.params[i].name, *c.params[i].value);
+            s += buf;
+        }
+        if (demo_effects.used) {
+            s += " effects ";
+            s += demo_effects.stack.spec();
+        }
+        if (demo_opts.jitter) {
+            s += " ";
+            s += demo_realtime.jitter.Summary();
+        }
+        snprintf(reply, len, "%s", s.c_str());
+    }
+    else {
+        for (int i=0; i < c.nparams; i++) {
+            const DemoControlParam &p = c.params[i];
+            if (strcmp(cmd, p.name) == 0) {
+                if (sscanf(arg, "%d", &a) != 1 || ((a < p.min || a > p.max) && a != p.also)) {
+                    goto invalid;
+                }
+                *p.value = a;
+                return true;
+            }
+        }
+        snprintf(reply, len, "error unknown command '%s'", cmd);
+        return false;
+    }
+    return true;
+
+invalid:
+    arg += strspn(arg, " \t");
+    snprintf(reply, len, "error invalid %s '%.*s'", cmd, (int)strcspn(arg, "\r\n"), arg);
+    return false;
+}
+
+// Applies the commands in a config file, reporting any errors.
+inline void demoLoadConfig(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return;
+    }
+    char line[256], reply[256];
+    for (int n=1; fgets(line, sizeof(line), f); n++) {
+        if (!demoCommand(line, reply, sizeof(reply))) {
+            fprintf(stderr, "%s:%d: %s\n", path, n, reply);
+        }
+    }
+    fclose(f);
+}
+
+// Opens the control port and applies the config file, once.
+inline void demoControlStart() {
+    DemoControl &c = demo_control;
+    if (c.started) return;
+    c.started = true;
+    if (demo_opts.control_port > 0) {
+        c.fd = socket(AF_INET, SOCK_DGRAM, 0);
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(demo_opts.control_port);
+        if (c.fd < 0 || bind(c.fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            perror("control port");
+            if (c.fd >= 0) close(c.fd);
+            c.fd = -1;
+        }
+    }
+    if (demo_opts.config_file) {
+        demoLoadConfig(demo_opts.config_file);
+        signal(SIGHUP, demoReloadHandler);
+    }
+}
+
+// Runs the commands that came in since the last frame, and reloads the
+// config file after a SIGHUP.
+inline void demoControlPoll() {
+    DemoControl &c = demo_control;
+    demoControlStart();
+    if (demo_reload) {
+        demo_reload = 0;
+        demoLoadConfig(demo_opts.config_file);
+    }
+    if (c.fd < 0) return;
+    char buf[1024];
+    struct sockaddr_in from;
+    socklen_t fromlen = sizeof(from);
+    ssize_t n;
+    while ((n = recvfrom(c.fd, buf, sizeof(buf) - 1, MSG_DONTWAIT,
+                         (struct sockaddr *)&from, &fromlen)) >= 0) {
+        buf[n] = '\0';
+        // a packet may hold several commands, one per line
+        std::string out;
+        char *save = NULL;
+        for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+            char reply[512];
+            demoCommand(line, reply, sizeof(reply));
+            if (reply[0]) {
+                out += reply;
+                out += '\n';
+            }
+        }
+        if (!out.empty()) {
+            sendto(c.fd, out.data(), out.size(), 0, (struct sockaddr *)&from, fromlen);
+        }
+        fromlen = sizeof(from);
+    }
+}
+
+// Holds the demo on its last frame until a resume, with the demo clock
+// stopped. Returns early on a signal so the demo can see an interrupt; it
+// pauses again at its next frame.
+inline void demoPause() {
+    const double start = monotonicSeconds();
+    while (demo_control.paused) {
+        struct pollfd p = { demo_control.fd, POLLIN, 0 };
+        if (poll(&p, (demo_control.fd >= 0) ? 1 : 0, DEMO_CONTROL_POLL) < 0
+            && errno == EINTR && !demo_reload) {
+            break;
+        }
+        demoControlPoll();
+    }
+    const double paused = monotonicSeconds() - start;
+    if (!demoVirtualClock()) {
+        const long nsec = demo_clock.start.tv_nsec + (long)((paused - (long)paused) * 1000000000.0);
+        demo_clock.start.tv_sec += (time_t)paused + nsec / 1000000000;
+        demo_clock.start.tv_nsec = nsec % 1000000000;
+    }
+    else if (demo_opts.pipeline > 0 && !demo_opts.fixed_clock && demo_clock.base >= 0) {
+        demo_clock.base = demo_clock.base + paused;
+    }
+}
+
+// The delay demoSleep(msec) waits between frames: msec, or the one set by the
+// control channel's delay command.
+inline int demoFrameDelay(int msec) {
+    return (demo_control.delay > 0) ? demo_control.delay : msec;
+}
+
+// Wait between frames. Frames are due msec apart; a frame that is more than
+// a whole delay late gives up the frames it missed rather than sending them
+// back to back, and the demo's animation, going by demoTime() or demoSteps(),
+// skips them too. In pipeline mode a frame was queued with its due time, so
+// only the clock moves on, over the frames the sender could no longer send
+// in time, and the demo blocks later if it gets too far ahead. A wait
+// without a frame before it, e.g. an idle loop, still sleeps.
+inline void demoSleep(int msec) {
+    demoRealtimeStart();    // for the demos without demoStart()
+    demoControlPoll();
+    if (demo_control.paused) {
+        demoPause();
+    }
+    msec = demoFrameDelay(msec);
+    if (demoGoverned() && demo_governor.render_start > 0
+        && demo_governor.render_end >= demo_governor.render_start) {
+        // the budget covers the frames interpolated after the one rendered
+        demoGovern(demo_governor.render_end - demo_governor.render_start,
+                   msec * demo_clock.frame_step);
+    }
+    demo_clock.frame_delay = msec;
+    if (demo_opts.fixed_clock) {
+        demoAdvance(msec);
+    }
+    else if (demo_opts.pipeline > 0) {
+        if (!demo_clock.frame_queued) {
+            usleep(msec * 1000);
+        }
+        demo_clock.frame_queued = false;
+        const double period = msec / 1000.0;
+        double due = demo_clock.virtual_time + period;
+        // as on the wall clock: the next frame, if more than a whole delay
+        // behind, is the latest one passed
+        const double base = demo_clock.base;
+        const double now = monotonicSeconds() - base;
+        if (base >= 0 && period > 0 && now - due > period) {
+            const long missed = (long)((now - due) / period);
+            demo_clock.skipped += missed;
+            due += missed * period;
+        }
+        demo_clock.virtual_time = due;
+    }
+    else {
+        const double period = msec / 1000.0;
+        const double now = demoElapsed();
+        double due = demo_clock.due + period;
+        // due on the grid of frames from demoStart(), the latest one passed
+        // if more than a whole delay behind
+        if (period > 0 && now - due > period) {
+            const long missed = (long)((now - due) / period);
+            demo_clock.skipped += missed;
+            due += missed * period;
+        }
+        if (due > now) {
+            const long nsec = demo_clock.start.tv_nsec + (long)((due - (long)due) * 1000000000.0);
+            struct timespec t;
+            t.tv_sec = demo_clock.start.tv_sec + (time_t)due + nsec / 1000000000;
+            t.tv_nsec = nsec % 1000000000;
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL);
+        }
+        if (demo_opts.jitter) {
+            demo_realtime.jitter.Add(demoElapsed() - due);
+        }
+        demo_clock.due = due;
+    }
+    const double t = demoElapsed();
+    demo_clock.frame_dt = t - demo_clock.frame_time;
+    demo_clock.frame_time = t;
+    if (demoGoverned()) {
+        demo_governor.render_start = monotonicSeconds();
+        demo_governor.render_end = -1;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Send Pipeline
+
+// A bounded single producer, single consumer ring of canvases between the demo
+// and the sender thread, a whole frame each. The canvases are allocated on
+// first use and again only when the size or socket changes, so queuing a frame
+// is one copy. Frames too big for one packet are split by the sender.
+class DemoPipeline {
+public:
+    ~DemoPipeline() {
+        if (!sender_.joinable()) return;
+        Flush();
+        stop_ = true;
+        Wake();
+        sender_.join();
+        for (int i=0; i < DEMO_PIPELINE_MAX; i++) {
+            delete slots_[i].canvas;
+        }
+    }
+
+    // Queues a copy of the pixels to be sent at the current demo time,
+    // waiting while the ring is full.
+    void Push(int socket, int width, int height, const uint8_t *pixels,
+              int off_x, int off_y, int off_z) {
+        if (!sender_.joinable()) {
+            depth_ = demo_opts.pipeline;
+            if (demo_clock.base < 0) {
+                demo_clock.base = monotonicSeconds() - demoElapsed();   // no demoStart()
+            }
+            sender_ = std::thread(&DemoPipeline::SenderLoop, this);
+        }
+        for (;;) {
+            const int sent = sent_.load();
+            if (queued_.load(std::memory_order_relaxed) - sent < depth_) break;
+            futexWait(&sent_, sent);
+        }
+
+        Slot &slot = slots_[write_];
+        if (!slot.canvas || slot.socket != socket
+            || slot.canvas->width() != width || slot.canvas->height() != height) {
+            delete slot.canvas;
+            slot.canvas = new UDPFlaschenTaschen(socket, width, height);
+            slot.socket = socket;
+        }
+        memcpy((void *)&slot.canvas->GetPixel(0, 0), pixels, width * height * 3);
+        slot.canvas->SetOffset(off_x, off_y, off_z);
+        slot.off_x = off_x; slot.off_y = off_y; slot.off_z = off_z;
+        slot.due = demoElapsed();
+        write_ = (write_ + 1) % depth_;
+
+        queued_.fetch_add(1);
+        Wake();
+        demo_clock.frame_queued = true;
+    }
+
+    // Sends everything queued without waiting for it to be due. For use
+    // before exit or before closing the socket.
+    void Flush() {
+        if (!sender_.joinable()) return;
+        flush_ = true;
+        Wake();
+        for (;;) {
+            const int sent = sent_.load();
+            if (sent == queued_.load()) break;
+            futexWait(&sent_, sent);
+        }
+        flush_ = false;
+    }
+
+private:
+    struct Slot {
+        UDPFlaschenTaschen *canvas = NULL;  // the whole frame, even if sent as several packets
+        int socket = -1;
+        int off_x = 0, off_y = 0, off_z = 0;
+        double due = 0;             // demo clock, seconds
+    };
+
+    void Wake() {
+        wake_.fetch_add(1);
+        futexWakeAll(&wake_);
+    }
+
+    void SenderLoop() {
+        demoRealtimeSender();
+        int read = 0;
+        for (;;) {
+            const int wake = wake_.load();
+            if (queued_.load() == sent_.load(std::memory_order_relaxed)) {
+                if (stop_) return;
+                futexWait(&wake_, wake);
+                continue;
+            }
+            Slot &slot = slots_[read];
+
+            // wait until the frame is due, or a flush. A late frame goes out
+            // at once; frames more than a delay late were skipped by demoSleep().
+            if (!demo_opts.fixed_clock) {
+                const double due = demo_clock.base + slot.due;
+                double now = monotonicSeconds();
+                while (now < due && !flush_) {
+                    const int wake = wake_.load();
+                    const double left = due - now;
+                    struct timespec ts;
+                    ts.tv_sec = (time_t)left;
+                    ts.tv_nsec = (long)((left - ts.tv_sec) * 1000000000.0);
+                    futexWait(&wake_, wake, &ts);
+                    now = monotonicSeconds();
+                }
+                if (demo_opts.jitter && !flush_) {
+                    demo_realtime.jitter.Add(now - due);
+                }
+            }
+            UDPFlaschenTaschen *canvas = slot.canvas;
+            if (framePacketsNeeded(canvas->width(), canvas->height(), demo_opts.packet_size)) {
+                packets_.Send(slot.socket, (const uint8_t *)&canvas->GetPixel(0, 0),
+                              canvas->width(), canvas->height(), demo_opts.packet_size,
+                              slot.off_x, slot.off_y, slot.off_z);
+            }
+            else {
+                canvas->Send();
+            }
+            read = (read + 1) % depth_;
+
+            sent_.fetch_add(1);
+            futexWakeAll(&sent_);
+        }
+    }
+
+    Slot slots_[DEMO_PIPELINE_MAX];
+    FramePacketSender packets_;     // sender thread only
+    int depth_ = 1;
+    int write_ = 0;                 // demo thread only
+    std::thread sender_;
+    std::atomic<bool> flush_{false};
+    std::atomic<bool> stop_{false};
+    alignas(64) std::atomic<int> queued_{0};
+    alignas(64) std::atomic<int> sent_{0};
+    std::atomic<int> wake_{0};
+};
+
+inline DemoPipeline demo_pipeline;
+
+// Sends any frames still queued in pipeline mode.
+inline void demoFlush() {
+    demo_pipeline.Flush();
+}
+
+// ------------------------------------------------------------------------------------------
+// Demo Canvas
+
+// 64 bit FNV-1a hash.
+inline uint64_t fnv1a(const void *data, size_t len, uint64_t hash = 0xcbf29ce484222325ULL) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i=0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Frame recording state shared by all canvases of a demo.
+struct DemoRecorder {
+    FILE *hash_out = NULL;
+    ClipWriter clip;
+    long frame = 0;
+    bool opened = false;
+};
+
+inline DemoRecorder demo_recorder;
+
+class DemoCanvas : public UDPFlaschenTaschen {
+public:
+    DemoCanvas(int socket, int width, int height)
+        : UDPFlaschenTaschen(socket, width, height), socket_(socket), surface_(width, height) {}
+    ~DemoCanvas() {
+        delete out_;
+        delete blend_;
+        delete [] error_;
+    }
+
+    using UDPFlaschenTaschen::Send;
+
+    void SetOffset(int offset_x, int offset_y, int offset_z = 0) {
+        off_x_ = offset_x; off_y_ = offset_y; off_z_ = offset_z;
+        UDPFlaschenTaschen::SetOffset(offset_x, offset_y, offset_z);
+    }
+
+    // The drawing calls go to the surface; the transmit buffer behind
+    // UDPFlaschenTaschen is only written by Send().
+    virtual void SetPixel(int x, int y, const Color &col) {
+        if (x >= 0 && x < width() && y >= 0 && y < height()) {
+            surface_.Row(y)[x] = Rgbx(col);
+        }
+    }
+    void Clear() { surface_.Clear(); }
+    void Fill(const Color &c) { fillSurface(surface_, Rgbx(c)); }
+    // Coordinates outside are wrapped around.
+    Color GetPixel(int x, int y) const {
+        x %= width(); if (x < 0) { x += width(); }
+        y %= height(); if (y < 0) { y += height(); }
+        return surface_.Row(y)[x].color();
+    }
+
+    Surface &surface() { return surface_; }
+
+    virtual void Send() {
+        if (demoGoverned()) {
+            demo_governor.render_end = monotonicSeconds();
+        }
+        uint8_t *pixels = (uint8_t *)&UDPFlaschenTaschen::GetPixel(0, 0);
+        packRgb24(surface_.data(), pixels, surface_.size());
+        if (demo_clock.frame_step > 1) {
+            Interpolate(pixels);
+        }
+        SendFrame(pixels);
+    }
+
+private:
+    // Sends the frames between the last frame rendered and this one, blended
+    // from the two and one frame delay apart, then keeps this one for the next.
+    void Interpolate(const uint8_t *pixels) {
+        const int step = demo_clock.frame_step;
+        const int n = width() * height() * 3;
+        if (!blend_) {
+            blend_ = new UDPFlaschenTaschen(socket_, width(), height());
+            last_.resize(n);
+        }
+        else {
+            uint8_t *blend = (uint8_t *)&blend_->GetPixel(0, 0);
+            for (int k=1; k < step; k++) {
+                lerpFrame(last_.data(), pixels, blend, n, k * 256 / step);
+                SendFrame(blend);
+                demoSleep(demo_clock.frame_delay);
+            }
+        }
+        memcpy(last_.data(), pixels, n);
+    }
+
+    // Sends the canvas, or an interpolated frame, through the output stages.
+    void SendFrame(const uint8_t *frame) {
+        // the control channel's layer and offset on top of the demo's
+        send_x_ = off_x_ + demo_control.dx;
+        send_y_ = off_y_ + demo_control.dy;
+        send_z_ = (demo_control.layer >= 0) ? demo_control.layer : off_z_;
+        demo_control.frames++;
+
+        const uint8_t *pixels = Output(frame);
+        const int w = out_ ? out_->width() : width();
+        const int h = out_ ? out_->height() : height();
+        if (demo_opts.hash_file || demo_opts.frame_dir || demo_opts.clip_file) {
+            Record(pixels, w, h);
+        }
+        if (demo_opts.pipeline > 0) {
+            demo_pipeline.Push(socket_, w, h, pixels, send_x_, send_y_, send_z_);
+        }
+        else if (framePacketsNeeded(w, h, demo_opts.packet_size)) {
+            packets_.Send(socket_, pixels, w, h, demo_opts.packet_size, send_x_, send_y_, send_z_);
+        }
+        else if (pixels == (const uint8_t *)&UDPFlaschenTaschen::GetPixel(0, 0)) {
+            UDPFlaschenTaschen::SetOffset(send_x_, send_y_, send_z_);
+            UDPFlaschenTaschen::Send();
+        }
+        else {
+            UDPFlaschenTaschen *out = (pixels == frame) ? blend_ : out_;
+            out->SetOffset(send_x_, send_y_, send_z_);
+            out->Send();
+        }
+    }
+
+    // Runs the output stages (see output-stage.h) on a copy of the frame.
+    // Returns the pixels to send, the frame itself if there is nothing to do.
+    const uint8_t *Output(const uint8_t *pixels) {
+        const double fade_out = (demo_opts.timeout >= 0) ? demo_opts.fade_out : 0;
+        const uint32_t level = fadeLevel(demoElapsed(), demo_opts.fade_in, fade_out, demo_opts.timeout);
+        const bool color = !demo_opts.color.identity() || demo_opts.dither || level != FADE_ONE;
+        const bool remap = !demo_opts.remap.identity();
+        if (!color && !remap) {
+            return pixels;
+        }
+        if (!out_) {
+            int w, h;
+            remapSize(demo_opts.remap, width(), height(), &w, &h);
+            out_ = new UDPFlaschenTaschen(socket_, w, h);
+            if (demo_opts.dither) {
+                error_ = new uint8_t[width() * height() * 3];
+                initDitherError(error_, width(), height());
+            }
+            if (remap) {
+                buildRemapTable(demo_opts.remap, width(), height(), remap_);
+                corrected_.resize(width() * height() * 3);
+            }
+        }
+        if (color_version_ != demo_control.color_version) {
+            // first use, or the control channel changed the brightness
+            color_version_ = demo_control.color_version;
+            buildColorLut16(demo_opts.color, base16_);
+            level_ = FADE_ONE + 1;
+        }
+        uint8_t *out = (uint8_t *)&out_->GetPixel(0, 0);
+        if (color) {
+            // color first, still in the canvas layout, then the remap into out
+            uint8_t *dst = remap ? corrected_.data() : out;
+            Correct(level, pixels, dst);
+            pixels = dst;
+        }
+        if (remap) {
+            applyRemap(remap_.data(), pixels, out, out_->width() * out_->height());
+        }
+        return out;
+    }
+
+    // Color correction, dithering and fade of the canvas pixels into dst.
+    void Correct(uint32_t level, const uint8_t *pixels, uint8_t *dst) {
+        // tables for this frame's fade level
+        if (level != level_) {
+            level_ = level;
+            if (demo_opts.dither) {
+                scaleLut16(base16_, level, lut16_);
+            }
+            else if (level == FADE_ONE) {
+                buildColorLut(demo_opts.color, lut_);
+            }
+            else {
+                scaleLut8(base16_, level, lut_);
+            }
+        }
+        if (demo_opts.dither) {
+            applyDitherLut(lut16_, pixels, dst, error_, width() * height());
+        }
+        else {
+            applyColorLut(lut_, pixels, dst, width() * height());
+        }
+    }
+
+    void Record(const uint8_t *pixels, int w, int h) {
+        DemoRecorder &rec = demo_recorder;
+        if (!rec.opened) {
+            rec.opened = true;
+            if (demo_opts.hash_file) {
+                rec.hash_out = (strcmp(demo_opts.hash_file, "-") == 0)
+                    ? stdout : fopen(demo_opts.hash_file, "w");
+                if (!rec.hash_out) {
+                    perror(demo_opts.hash_file);
+                }
+            }
+            if (demo_opts.clip_file) {
+                rec.clip.Open(demo_opts.clip_file);
+            }
+        }
+        rec.frame++;
+
+        if (rec.hash_out) {
+            const int offsets[3] = { send_x_, send_y_, send_z_ };
+            uint64_t hash = fnv1a(offsets, sizeof(offsets));
+            hash = fnv1a(pixels, w * h * 3, hash);
+            fprintf(rec.hash_out, "%ld %016llx\n", rec.frame, (unsigned long long)hash);
+            fflush(rec.hash_out);
+        }
+        if (demo_opts.frame_dir) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/frame-%06ld.ppm", demo_opts.frame_dir, rec.frame);
+            FILE *f = fopen(path, "wb");
+            if (f) {
+                fprintf(f, "P6\n%d %d\n255\n", w, h);
+                fwrite(pixels, 3, w * h, f);
+                fclose(f);
+            }
+        }
+        if (demo_opts.clip_file) {
+            rec.clip.Write((uint32_t)(demoElapsed() * 1000 + 0.5), w, h, send_x_, send_y_, send_z_, pixels);
+        }
+    }
+
+    const int socket_;
+    Surface surface_;                   // what the demo draws
+    int off_x_ = 0, off_y_ = 0, off_z_ = 0;
+    int send_x_ = 0, send_y_ = 0, send_z_ = 0;  // with the control channel's changes
+    UDPFlaschenTaschen *out_ = NULL;    // output stage result
+    UDPFlaschenTaschen *blend_ = NULL;  // interpolated frame
+    std::vector<uint8_t> last_;         // last frame rendered, when interpolating
+    FramePacketSender packets_;         // when a frame doesn't fit in one packet
+    uint8_t lut_[3][256];
+    uint16_t base16_[3][256];           // 8.8 fixed point, before the fade
+    uint16_t lut16_[3][256];            // 8.8 fixed point, with --dither
+    uint32_t level_ = FADE_ONE + 1;     // fade level the tables were built for
+    int color_version_ = -1;            // of demo_control the tables were built for
+    uint8_t *error_ = NULL;             // dither fraction carried per subpixel
+    std::vector<int32_t> remap_;        // canvas pixel for every output pixel
+    std::vector<uint8_t> corrected_;    // color stage result when remapping
+};
+
+#endif  // DEMO_RUNTIME_H
@@ -0,0 +1,479 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// effects
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+// 18/10/2026 - Apply() also takes the Rgbx render surface (surface.h).
+//
+// A stack of post-processing effects a demo runs over its index buffer
+// (uint8_t) or color buffer (Color) every frame, in place of the "blur, then
+// drop by BLUR_DROP" loops each demo used to carry. The stack is parsed from a
+// line of text, so a new look is a command line option or a config line
+// rather than a new demo:
+//
+//  EffectStack fx;
+//  fx.Parse("blur,decay:32", &error);
+//  fx.Apply(pixels, width, height);
+//
+// Effects, applied left to right (arguments after colons, all optional):
+//
+//  blur                      2x2 box blur towards the lower right; 1-2-1 on strips
+//  gaussian                  3x3 Gaussian blur
+//  glow:<level>:<gain>       adds a blurred copy of what is above level (128),
+//                            gain/64 strong (64)
+//  smear:<dx>:<dy>           averages each pixel with the one dx, dy back (1, 0)
+//  zoom:<percent>            scales about the center (105), for feedback tunnels
+//  decay:<n>                 subtracts n (8)
+//  trails:<keep>             scales by keep/256 (224)
+//  threshold:<level>         black below level (128)
+//
+// Outside the buffer is black for all of them. Color buffers are worked on a
+// channel at a time, Rgbx ones too: the padding byte is 0 and stays 0.
+//
+// The per-pixel effects (decay, trails, threshold) are fused into the pass
+// before them, so "blur,decay:32" reads and writes the buffer once. Decays on
+// their own stay a saturating subtract, which vectorizes along with the blur;
+// anything else goes through a 256 entry lookup table. The kernels work a row
+// at a time from aligned scratch rows, so the compiler can vectorize them.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include "udp-flaschen-taschen.h"
+#include "pixel-buffer.h"
+#include "surface.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define EFFECT_PASSES_MAX 16
+#define EFFECT_ARGS_MAX 2
+
+static_assert(sizeof(Color) == 3, "effects work on Color as three bytes");
+
+enum EffectKind {
+    EFFECT_NONE,        // only the per-pixel part, for a stack that starts with one
+    EFFECT_BLUR,
+    EFFECT_GAUSSIAN,
+    EFFECT_GLOW,
+    EFFECT_SMEAR,
+    EFFECT_ZOOM,
+};
+
+// One read and write of the buffer: a neighbourhood effect and the per-pixel
+// effects after it.
+struct EffectPass {
+    EffectKind kind;
+    int arg[EFFECT_ARGS_MAX];
+    bool use_lut;       // false: the per-pixel part is a subtract of decay
+    int decay;
+    uint8_t lut[256];
+};
+
+// ------------------------------------------------------------------------------------------
+// Per-pixel part
+
+// Both take and give bytes, so the kernels' arithmetic stays narrow enough to
+// vectorize well.
+struct EffectDecay {
+    uint8_t decay;
+    inline uint8_t operator()(uint8_t v) const { return (v > decay) ? v - decay : 0; }
+};
+
+struct EffectLut {
+    const uint8_t *lut;
+    inline uint8_t operator()(uint8_t v) const { return lut[v]; }
+};
+
+// ------------------------------------------------------------------------------------------
+// Kernels
+//
+// p is width * C bytes a row, C = 1 for index buffers and 3 for Color. The
+// scratch rows hold C bytes of black either side of the row.
+
+struct EffectScratch {
+    PixelBuffer<uint8_t> rows;      // two padded rows, or one and black
+    PixelBuffer<uint8_t> frame;     // a copy of the buffer
+    PixelBuffer<uint16_t> sums;     // horizontal 1-2-1 sums, a row per row
+    std::vector<int> map;           // zoom: source offset of each column, row
+};
+
+// Pixel and the ones right, below and below right, / 4. It only reads pixels
+// it hasn't written yet, so it works in place.
+template <int C, class Point>
+void effectBlur(uint8_t *p, int width, int height, Point point, EffectScratch &s) {
+
+    const int rb = width * C;
+    s.rows.Resize(rb + 2 * C, 2);
+    memset(s.rows.Row(0), 0, s.rows.size());
+
+    if (height == 1) {
+        // a strip has nothing below: 1-2-1 along it instead
+        uint8_t *cur = s.rows.Row(0) + C;
+        memcpy(cur, p, rb);
+        for (int i=0; i < rb; i++) {
+            p[i] = point((uint8_t)((cur[i - C] + 2 * cur[i] + cur[i + C]) >> 2));
+        }
+        return;
+    }
+
+    const uint8_t *black = s.rows.Row(1);
+    for (int y=0; y < height; y++) {
+        uint8_t *row = p + (size_t)y * rb;
+        const uint8_t *below = (y + 1 < height) ? row + rb : black;
+        for (int i=0; i < rb - C; i++) {
+            row[i] = point((uint8_t)((row[i] + row[i + C] + below[i] + below[i + C]) >> 2));
+        }
+        // right column
+        for (int i=rb - C; i < rb; i++) {
+            row[i] = point((uint8_t)((row[i] + below[i]) >> 2));
+        }
+    }
+}
+
+// Horizontal 1-2-1 sums of max(v - level, 0) into s.sums, ready for the
+// vertical half of a Gaussian.
+template <int C>
+void effectRowSums(const uint8_t *p, int width, int height, int level, EffectScratch &s) {
+
+    const int rb = width * C;
+    s.rows.Resize(rb + 2 * C, 2);
+    s.sums.Resize(rb, height + 2);
+    uint8_t *bright = s.rows.Row(0) + C;
+    memset(s.rows.Row(0), 0, s.rows.size());
+    memset(s.sums.Row(0), 0, rb * sizeof(uint16_t));
+    memset(s.sums.Row(height + 1), 0, rb * sizeof(uint16_t));
+
+    for (int y=0; y < height; y++) {
+        const uint8_t *row = p + (size_t)y * rb;
+        for (int i=0; i < rb; i++) {
+            bright[i] = (row[i] > level) ? row[i] - level : 0;
+        }
+        uint16_t *__restrict sum = s.sums.Row(y + 1);
+        const uint8_t *__restrict b = bright;
+        for (int i=0; i < rb; i++) {
+            sum[i] = b[i - C] + 2 * b[i] + b[i + C];
+        }
+    }
+}
+
+template <int C, class Point>
+void effectGaussian(uint8_t *p, int width, int height, Point point, EffectScratch &s) {
+
+    const int rb = width * C;
+    effectRowSums<C>(p, width, height, 0, s);
+    for (int y=0; y < height; y++) {
+        const uint16_t *__restrict up = s.sums.Row(y);
+        const uint16_t *__restrict mid = s.sums.Row(y + 1);
+        const uint16_t *__restrict down = s.sums.Row(y + 2);
+        uint8_t *__restrict out = p + (size_t)y * rb;
+        for (int i=0; i < rb; i++) {
+            out[i] = point((uint8_t)((up[i] + 2 * mid[i] + down[i]) >> 4));
+        }
+    }
+}
+
+template <int C, class Point>
+void effectGlow(uint8_t *p, int width, int height, int level, int gain, Point point,
+                EffectScratch &s) {
+
+    const int rb = width * C;
+    effectRowSums<C>(p, width, height, level, s);
+    for (int y=0; y < height; y++) {
+        const uint16_t *__restrict up = s.sums.Row(y);
+        const uint16_t *__restrict mid = s.sums.Row(y + 1);
+        const uint16_t *__restrict down = s.sums.Row(y + 2);
+        uint8_t *__restrict out = p + (size_t)y * rb;
+        for (int i=0; i < rb; i++) {
+            const int v = out[i] + ((((up[i] + 2 * mid[i] + down[i]) >> 4) * gain) >> 6);
+            out[i] = point((uint8_t)((v > 255) ? 255 : v));
+        }
+    }
+}
+
+// Average of each pixel and the one (dx, dy) back, so that fed back frame to
+// frame, things leave a streak behind them in that direction.
+template <int C, class Point>
+void effectSmear(uint8_t *p, int width, int height, int dx, int dy, Point point,
+                 EffectScratch &s) {
+
+    const int rb = width * C;
+    s.frame.Resize(rb, height);
+    memcpy(s.frame.data(), p, (size_t)rb * height);
+
+    // columns x with x - dx inside
+    const int x0 = (dx > 0) ? ((dx < width) ? dx : width) : 0;
+    const int x1 = (dx < 0) ? ((width + dx > 0) ? width + dx : 0) : width;
+    for (int y=0; y < height; y++) {
+        uint8_t *__restrict out = p + (size_t)y * rb;
+        const int sy = y - dy;
+        if (sy < 0 || sy >= height) {
+            for (int i=0; i < rb; i++) { out[i] = point((uint8_t)((out[i] + 1) >> 1)); }
+            continue;
+        }
+        const uint8_t *__restrict back = s.frame.Row(sy) - dx * C;
+        const uint8_t *__restrict here = s.frame.Row(y);
+        for (int i=0; i < x0 * C; i++) { out[i] = point((uint8_t)((here[i] + 1) >> 1)); }
+        for (int i=x0 * C; i < x1 * C; i++) { out[i] = point((uint8_t)((here[i] + back[i] + 1) >> 1)); }
+        for (int i=x1 * C; i < rb; i++) { out[i] = point((uint8_t)((here[i] + 1) >> 1)); }
+    }
+}
+
+// Source of destination column (or row) i when scaling n pixels by
+// percent / 100 about the center, nearest pixel, -1 outside.
+inline int effectZoomSource(int i, int n, int percent) {
+    const int64_t num = (int64_t)n * percent + (int64_t)(2 * i + 1 - n) * 100;
+    const int64_t den = 2 * (int64_t)percent;
+    const int64_t s = (num >= 0) ? num / den : -((-num + den - 1) / den);
+    return (s >= 0 && s < n) ? (int)s : -1;
+}
+
+template <int C, class Point>
+void effectZoom(uint8_t *p, int width, int height, int percent, Point point, EffectScratch &s) {
+
+    const int rb = width * C;
+    s.frame.Resize(rb, height);
+    memcpy(s.frame.data(), p, (size_t)rb * height);
+    s.map.resize(width);
+    for (int x=0; x < width; x++) {
+        const int sx = effectZoomSource(x, width, percent);
+        s.map[x] = (sx < 0) ? -1 : sx * C;
+    }
+
+    for (int y=0; y < height; y++) {
+        uint8_t *out = p + (size_t)y * rb;
+        const int sy = effectZoomSource(y, height, percent);
+        if (sy < 0) {
+            for (int i=0; i < rb; i++) { out[i] = point(0); }
+            continue;
+        }
+        const uint8_t *src = s.frame.Row(sy);
+        for (int x=0; x < width; x++) {
+            const int at = s.map[x];
+            for (int c=0; c < C; c++) {
+                out[x * C + c] = point((at < 0) ? 0 : src[at + c]);
+            }
+        }
+    }
+}
+
+template <int C, class Point>
+void effectPass(const EffectPass &e, uint8_t *p, int width, int height, Point point,
+                EffectScratch &s) {
+    const int n = width * height * C;
+    switch (e.kind) {
+    case EFFECT_NONE:
+        for (int i=0; i < n; i++) { p[i] = point(p[i]); }
+        break;
+    case EFFECT_BLUR:     effectBlur<C>(p, width, height, point, s); break;
+    case EFFECT_GAUSSIAN: effectGaussian<C>(p, width, height, point, s); break;
+    case EFFECT_GLOW:     effectGlow<C>(p, width, height, e.arg[0], e.arg[1], point, s); break;
+    case EFFECT_SMEAR:    effectSmear<C>(p, width, height, e.arg[0], e.arg[1], point, s); break;
+    case EFFECT_ZOOM:     effectZoom<C>(p, width, height, e.arg[0], point, s); break;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Stack
+
+class EffectStack {
+public:
+    EffectStack() {}
+    EffectStack(const EffectStack &) = delete;
+    EffectStack &operator=(const EffectStack &) = delete;
+
+    // Replaces the stack with the one in spec, e.g. "blur,decay:32"; "" or
+    // "none" is no effects. Leaves it as it was if spec is invalid.
+    bool Parse(const char *spec, std::string *error) {
+        EffectPass passes[EFFECT_PASSES_MAX];
+        int n = 0;
+        std::string text = spec ? spec : "";
+        if (text == "none") text = "";
+
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find(',', start);
+            if (end == std::string::npos) end = text.size();
+            const std::string item = text.substr(start, end - start);
+            start = end + 1;
+
+            // name and up to EFFECT_ARGS_MAX integer arguments
+            char name[16];
+            int arg[EFFECT_ARGS_MAX] = { INT32_MIN, INT32_MIN };
+            int len = 0;
+            if (sscanf(item.c_str(), "%15[a-z]%n", name, &len) != 1) {
+                *error = "invalid effect '" + item + "'";
+                return false;
+            }
+            const char *rest = item.c_str() + len;
+            int nargs = 0;
+            while (*rest == ':' && nargs < EFFECT_ARGS_MAX) {
+                char *after;
+                const long v = strtol(rest + 1, &after, 10);
+                if (after == rest + 1) break;
+                arg[nargs++] = (int)v;
+                rest = after;
+            }
+            if (*rest) {
+                *error = "invalid effect '" + item + "'";
+                return false;
+            }
+
+            EffectKind kind = EFFECT_NONE;
+            int point = -1;     // decay, trails or threshold
+            if      (strcmp(name, "blur") == 0)      { kind = EFFECT_BLUR; }
+            else if (strcmp(name, "gaussian") == 0)  { kind = EFFECT_GAUSSIAN; }
+            else if (strcmp(name, "glow") == 0)      { kind = EFFECT_GLOW; }
+            else if (strcmp(name, "smear") == 0)     { kind = EFFECT_SMEAR; }
+            else if (strcmp(name, "zoom") == 0)      { kind = EFFECT_ZOOM; }
+            else if (strcmp(name, "decay") == 0)     { point = 0; }
+            else if (strcmp(name, "trails") == 0)    { point = 1; }
+            else if (strcmp(name, "threshold") == 0) { point = 2; }
+            else {
+                *error = "unknown effect '" + item + "'";
+                return false;
+            }
+
+            // by kind, then decay, trails and threshold
+            const int max_args[] = { 0, 0, 0, 2, 2, 1 };
+            const int defaults[][EFFECT_ARGS_MAX] = {
+                { 0, 0 }, { 0, 0 }, { 0, 0 }, { 128, 64 }, { 1, 0 }, { 105, 0 },
+            };
+            const int point_defaults[] = { 8, 224, 128 };
+            if (nargs > ((point >= 0) ? 1 : max_args[kind])) {
+                *error = "too many arguments in '" + item + "'";
+                return false;
+            }
+            for (int i=0; i < EFFECT_ARGS_MAX; i++) {
+                if (arg[i] == INT32_MIN) {
+                    arg[i] = (point >= 0) ? point_defaults[point] : defaults[kind][i];
+                }
+            }
+
+            bool valid = true;
+            if (point >= 0) {
+                valid = (arg[0] >= 0) && (arg[0] <= ((point == 1) ? 256 : 255));
+            }
+            else if (kind == EFFECT_GLOW) {
+                valid = (arg[0] >= 0 && arg[0] <= 255 && arg[1] >= 0 && arg[1] <= 1024);
+            }
+            else if (kind == EFFECT_SMEAR) {
+                valid = (abs(arg[0]) <= 64 && abs(arg[1]) <= 64);
+            }
+            else if (kind == EFFECT_ZOOM) {
+                valid = (arg[0] >= 25 && arg[0] <= 400);
+            }
+            if (!valid) {
+                *error = "invalid effect '" + item + "'";
+                return false;
+            }
+
+            if (point < 0 || n == 0) {
+                if (n == EFFECT_PASSES_MAX) {
+                    *error = "too many effects";
+                    return false;
+                }
+                EffectPass &e = passes[n++];
+                e.kind = kind;
+                e.arg[0] = arg[0];
+                e.arg[1] = arg[1];
+                e.use_lut = false;
+                e.decay = 0;
+            }
+            if (point >= 0) {
+                addPoint(passes[n - 1], point, arg[0]);
+            }
+        }
+
+        for (int i=0; i < n; i++) { passes_[i] = passes[i]; }
+        passes_n_ = n;
+        spec_ = text.empty() ? "none" : text;
+        return true;
+    }
+
+    bool empty() const { return passes_n_ == 0; }
+    const char *spec() const { return spec_.c_str(); }
+
+    void Apply(uint8_t pixels[], int width, int height) {
+        apply<1>(pixels, width, height);
+    }
+    void Apply(Color pixels[], int width, int height) {
+        apply<3>((uint8_t *)pixels, width, height);
+    }
+    void Apply(PixelBuffer<uint8_t> &pixels) {
+        apply<1>(pixels.data(), pixels.width(), pixels.height());
+    }
+    void Apply(PixelBuffer<Color> &pixels) {
+        apply<3>((uint8_t *)pixels.data(), pixels.width(), pixels.height());
+    }
+    void Apply(Rgbx pixels[], int width, int height) {
+        apply<4>((uint8_t *)pixels, width, height);
+    }
+    void Apply(PixelBuffer<Rgbx> &pixels) {
+        apply<4>((uint8_t *)pixels.data(), pixels.width(), pixels.height());
+    }
+
+private:
+    // Folds a per-pixel effect into the pass: decays add up, anything else
+    // turns the pass over to the lookup table.
+    static void addPoint(EffectPass &e, int point, int arg) {
+        if (point == 0 && !e.use_lut) {
+            e.decay = (e.decay + arg > 255) ? 255 : e.decay + arg;
+            return;
+        }
+        if (!e.use_lut) {
+            const EffectDecay d = { (uint8_t)e.decay };
+            for (int v=0; v < 256; v++) { e.lut[v] = d(v); }
+            e.use_lut = true;
+        }
+        for (int v=0; v < 256; v++) {
+            const int x = e.lut[v];
+            e.lut[v] = (point == 0) ? ((x > arg) ? x - arg : 0)
+                     : (point == 1) ? (x * arg) >> 8
+                     : (x < arg) ? 0 : x;
+        }
+    }
+
+    template <int C>
+    void apply(uint8_t *p, int width, int height) {
+        if (width < 1 || height < 1) return;
+        for (int i=0; i < passes_n_; i++) {
+            const EffectPass &e = passes_[i];
+            if (e.use_lut) {
+                effectPass<C>(e, p, width, height, EffectLut{ e.lut }, scratch_);
+            }
+            else {
+                effectPass<C>(e, p, width, height, EffectDecay{ (uint8_t)e.decay }, scratch_);
+            }
+        }
+    }
+
+    EffectPass passes_[EFFECT_PASSES_MAX];
+    int passes_n_ = 0;
+    std::string spec_ = "none";
+    EffectScratch scratch_;
+};
+
+#endif  // EFFECTS_H
@@ -0,0 +1,172 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// fast-trig
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Sine, cosine and square roots for the demos without calling libm.
+//
+// Animation that moves things along sine waves (plasma's windows, hack's
+// spinning characters) keeps its angle as a TrigPhase, where a whole turn is
+// 2^32, so the angle wraps for free and the speed can be a constant added or
+// multiplied in each frame. fastSin() and fastCos() look the phase up in a
+// constexpr table of TRIG_TABLE_SIZE entries and interpolate linearly, giving
+// Q16.16 results (fixed-point.h) good to about 2^-15:
+//
+//  const TrigPhase speed = trigPhase(1 / 97.0);   // radians per frame
+//  x = hw + (fastCos(speed * count) * hw).round();
+//
+// For filling big tables at startup there are float versions, fastSinf(),
+// fastCosf() and fastHypotf() (through a fast inverse square root), and batch
+// versions that run them over an array. These are branch-free polynomials
+// rather than table lookups, so the compiler vectorizes the batch loops with
+// SSE or NEON. They are good to about 1e-6 for arguments below 10^5.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef FAST_TRIG_H
+#define FAST_TRIG_H
+
+#include "fixed-point.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define TRIG_TABLE_BITS 10
+#define TRIG_TABLE_SIZE (1 << TRIG_TABLE_BITS)     // entries per turn
+
+// An angle in 1/2^32 of a turn.
+typedef uint32_t TrigPhase;
+
+// For |radians| below about 10^9.
+constexpr TrigPhase trigPhase(double radians) {
+    const double t = radians * (4294967296.0 / (2 * M_PI));
+    return (TrigPhase)(uint64_t)(int64_t)(t + ((t < 0) ? -0.5 : 0.5));
+}
+
+constexpr TrigPhase trigDegrees(double degrees) {
+    return trigPhase(degrees * (M_PI / 180));
+}
+
+// ------------------------------------------------------------------------------------------
+// Table
+
+// sin(x) for x in [-pi, pi], by its Taylor series; <cmath> isn't constexpr.
+constexpr double trigSeries(double x) {
+    double term = x, sum = x;
+    for (int n=1; n < 16; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// One turn of sine in Q16.16, with the first entry repeated at the end so
+// the interpolation never wraps.
+struct TrigTable {
+    int32_t sine[TRIG_TABLE_SIZE + 1];
+};
+
+constexpr TrigTable makeTrigTable() {
+    TrigTable t = {};
+    for (int k=0; k <= TRIG_TABLE_SIZE; k++) {
+        const double turn = (double)(k % TRIG_TABLE_SIZE) / TRIG_TABLE_SIZE;
+        const double x = 2 * M_PI * ((turn <= 0.5) ? turn : turn - 1);
+        t.sine[k] = Q16_16::fromFloat(trigSeries(x)).raw;
+    }
+    return t;
+}
+
+inline constexpr TrigTable kTrigTable = makeTrigTable();
+
+inline Q16_16 fastSin(TrigPhase phase) {
+    const int i = phase >> (32 - TRIG_TABLE_BITS);
+    const int32_t f = (phase >> (16 - TRIG_TABLE_BITS)) & 0xFFFF;
+    const int32_t a = kTrigTable.sine[i], b = kTrigTable.sine[i + 1];
+    Q16_16 s;
+    s.raw = a + (((b - a) * f) >> 16);   // |b - a| < 2^9, no overflow
+    return s;
+}
+
+inline Q16_16 fastCos(TrigPhase phase) {
+    return fastSin(phase + (1u << 30));
+}
+
+// ------------------------------------------------------------------------------------------
+// Float
+
+// sin(x), reduced to [-pi/2, pi/2] with arithmetic only (no selects, so the
+// batch loops vectorize) and then a Taylor polynomial to x^11.
+inline float fastSinf(float x) {
+    // nearest whole turn by the 1.5 * 2^23 rounding trick, then x - k * 2pi
+    // in two parts so it stays exact
+    const float k = (x * (float)(1 / (2 * M_PI)) + 12582912.0f) - 12582912.0f;
+    const float r = (x - k * 6.28125f) - k * (float)(2 * M_PI - 6.28125);
+    // sin(pi - r) = sin(r) folds [-pi, pi] into [-pi/2, pi/2]; r can be a
+    // hair past pi, so multiply by the sign rather than copy it
+    const float a = copysignf(1.0f, r) * ((float)(M_PI / 2) - fabsf(fabsf(r) - (float)(M_PI / 2)));
+    const float a2 = a * a;
+    return a * (1 + a2 * (-1.0f / 6 + a2 * (1.0f / 120 + a2 * (-1.0f / 5040
+             + a2 * (1.0f / 362880 + a2 * (-1.0f / 39916800))))));
+}
+
+inline float fastCosf(float x) {
+    return fastSinf(x + (float)(M_PI / 2));
+}
+
+// 1/sqrt(x) for x > 0: the integer estimate and two Newton steps.
+inline float fastInvSqrtf(float x) {
+    uint32_t i;
+    float y;
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5f375a86 - (i >> 1);
+    memcpy(&y, &i, sizeof(y));
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+// The estimate for 0 is finite, so hypot(0, 0) is 0 without a test.
+inline float fastHypotf(float x, float y) {
+    const float d = x * x + y * y;
+    return d * fastInvSqrtf(d);
+}
+
+// out[i] = sin(x[i]); out may be x.
+inline void fastSinBatch(const float x[], float out[], int n) {
+    for (int i=0; i < n; i++) {
+        out[i] = fastSinf(x[i]);
+    }
+}
+
+// out[i] = cos(x[i]); out may be x.
+inline void fastCosBatch(const float x[], float out[], int n) {
+    for (int i=0; i < n; i++) {
+        out[i] = fastCosf(x[i]);
+    }
+}
+
+// out[i] = hypot(x[i], y), e.g. distances along a row; out may be x.
+inline void fastHypotBatch(const float x[], float y, float out[], int n) {
+    for (int i=0; i < n; i++) {
+        out[i] = fastHypotf(x[i], y);
+    }
+}
+
+#endif  // FAST_TRIG_H
@@ -0,0 +1,153 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// fixed-point
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Q-format fixed-point numbers for the inner loops that used float or double
+// where integer arithmetic does, for the ARM boards without a fast FPU.
+//
+// Fixed<F, T, W> keeps a value as raw / 2^F in the integer type T, with the
+// wider type W for products and quotients. Q8_8 (16 bit) is enough for
+// weights and small coordinates, Q16_16 (32 bit) for everything else. Adding,
+// subtracting and multiplying saturate at the limits of T instead of wrapping,
+// so an overflow shows as a clipped value rather than a jump across the
+// screen. Converting from float is constexpr, so constants cost nothing at
+// run time:
+//
+//  const Q16_16 half = Q16_16::fromFloat(0.5);
+//  Q16_16 y = Q16_16::fromInt(y1) + Q16_16::ratio(dy, dx);
+//  int row = y.floor();
+//  int level = (y.frac() * 255).floor();
+//
+// Dividing still costs an integer divide, which the older ARM cores do in
+// software, so reciprocal() looks 1/x up in a table for Q8_8 values below
+// FIXED_RECIPROCAL_LIMIT instead: a divide becomes a multiply.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+#include <limits>
+
+#define FIXED_RECIPROCAL_LIMIT 32   // reciprocal() covers Q8_8 values below this
+
+template <int F, class T, class W> struct Fixed {
+    static_assert(F > 0 && F < (int)sizeof(T) * 8 - 1, "fraction bits don't fit");
+    static_assert(sizeof(W) > sizeof(T), "W must be wider than T");
+
+    static constexpr int kFracBits = F;
+    static constexpr T kOne = (T)((W)1 << F);
+
+    T raw;  // value * 2^F
+
+    Fixed() = default;  // uninitialized, like the built-in types; Fixed() is zero
+
+    // Clamps to the range of T.
+    static constexpr Fixed fromRaw(W raw) {
+        Fixed f = Fixed();
+        f.raw = (raw > (W)std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max()
+              : (raw < (W)std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min()
+              : (T)raw;
+        return f;
+    }
+    static constexpr Fixed fromInt(int i) { return fromRaw((W)i * kOne); }
+    static constexpr Fixed fromFloat(double d) {
+        const double scaled = d * kOne;
+        return fromRaw((W)(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+    }
+    // num / den, rounded to nearest. den must not be 0.
+    static constexpr Fixed ratio(int num, int den) {
+        const W n = (W)num * kOne * 2;
+        const W q = n / den;
+        return fromRaw((q + ((q < 0) ? -1 : 1)) / 2);
+    }
+
+    // Round towards minus infinity, towards zero, or to nearest.
+    constexpr int floor() const { return (int)(raw >> F); }
+    constexpr int trunc() const { return (raw < 0) ? -(int)(-(W)raw >> F) : (int)(raw >> F); }
+    constexpr int round() const { return (int)(((W)raw + (kOne >> 1)) >> F); }
+    // Always in [0..1), also for negative values (x - floor(x)).
+    constexpr Fixed frac() const { Fixed f = Fixed(); f.raw = raw & (kOne - 1); return f; }
+    constexpr double toFloat() const { return (double)raw / kOne; }
+
+    // Same value in another Q format; drops fraction bits towards minus infinity.
+    template <class Q> constexpr Q to() const {
+        if constexpr (Q::kFracBits >= F) {
+            return Q::fromRaw((int64_t)raw << (Q::kFracBits - F));
+        }
+        else {
+            return Q::fromRaw((int64_t)raw >> (F - Q::kFracBits));
+        }
+    }
+
+    constexpr Fixed operator+(Fixed b) const { return fromRaw((W)raw + b.raw); }
+    constexpr Fixed operator-(Fixed b) const { return fromRaw((W)raw - b.raw); }
+    constexpr Fixed operator-() const { return fromRaw(-(W)raw); }
+    constexpr Fixed operator*(Fixed b) const { return fromRaw(((W)raw * b.raw) >> F); }
+    constexpr Fixed operator*(int i) const { return fromRaw((W)raw * i); }
+    // An integer divide; see reciprocal(). b must not be 0.
+    constexpr Fixed operator/(Fixed b) const { return fromRaw(((W)raw << F) / b.raw); }
+
+    Fixed &operator+=(Fixed b) { return *this = *this + b; }
+    Fixed &operator-=(Fixed b) { return *this = *this - b; }
+    Fixed &operator*=(Fixed b) { return *this = *this * b; }
+
+    constexpr bool operator==(Fixed b) const { return raw == b.raw; }
+    constexpr bool operator!=(Fixed b) const { return raw != b.raw; }
+    constexpr bool operator<(Fixed b) const { return raw < b.raw; }
+    constexpr bool operator>(Fixed b) const { return raw > b.raw; }
+    constexpr bool operator<=(Fixed b) const { return raw <= b.raw; }
+    constexpr bool operator>=(Fixed b) const { return raw >= b.raw; }
+};
+
+typedef Fixed<8, int16_t, int32_t> Q8_8;
+typedef Fixed<16, int32_t, int64_t> Q16_16;
+
+// ------------------------------------------------------------------------------------------
+// Reciprocals
+
+#define FIXED_RECIPROCAL_SIZE (FIXED_RECIPROCAL_LIMIT << 8)
+
+// 1/x in Q16.16 for every positive Q8.8 value x below FIXED_RECIPROCAL_LIMIT.
+struct FixedReciprocalTable {
+    int32_t value[FIXED_RECIPROCAL_SIZE];
+};
+
+constexpr FixedReciprocalTable makeFixedReciprocals() {
+    FixedReciprocalTable t = {};
+    t.value[0] = std::numeric_limits<int32_t>::max();
+    for (int i=1; i < FIXED_RECIPROCAL_SIZE; i++) {
+        t.value[i] = (int32_t)((((int64_t)1 << 24) + i / 2) / i);
+    }
+    return t;
+}
+
+inline constexpr FixedReciprocalTable kFixedReciprocals = makeFixedReciprocals();
+
+// 1/x without a divide, for 0 < x < FIXED_RECIPROCAL_LIMIT; x is clamped to
+// that range, and negative x gives -1/|x|.
+inline Q16_16 reciprocal(Q8_8 x) {
+    const int i = (x.raw < 0) ? -x.raw : x.raw;
+    const int32_t r = kFixedReciprocals.value[(i < FIXED_RECIPROCAL_SIZE) ? i : FIXED_RECIPROCAL_SIZE - 1];
+    return Q16_16::fromRaw((x.raw < 0) ? -(int64_t)r : r);
+}
+
+#endif  // FIXED_POINT_H
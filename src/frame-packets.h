@@ -0,0 +1,131 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// frame-packets
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Frames too big for one UDP packet, such as long strips, sent as several.
+// Each packet is a part of the frame with its own offset: a band of whole
+// rows or, for rows too long themselves, a run of one row, so the server puts
+// them back together without knowing they were split.
+//
+// FramePacketSender keeps a canvas per packet, allocated when the frame size
+// changes, and is used by the demos' canvas, the send pipeline's thread and
+// the clip player alike:
+//
+//  FramePacketSender sender;
+//  if (framePacketsNeeded(width, height, max_bytes)) {
+//      sender.Send(socket, pixels, width, height, max_bytes, off_x, off_y, layer);
+//  }
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef FRAME_PACKETS_H
+#define FRAME_PACKETS_H
+
+#include "udp-flaschen-taschen.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#define FRAME_PACKET_MAX 65507      // largest UDP payload
+#define FRAME_PACKET_MIN 256
+#define FRAME_PACKET_HEADER 64      // room for the PPM header and offset footer
+
+// Part of a frame sent as a packet of its own: a band of whole rows, or a run
+// of one row. Either way its pixels are contiguous in the frame.
+struct FramePacket {
+    int x, y, width, height;
+    UDPFlaschenTaschen *canvas;
+};
+
+// True if a width x height frame doesn't fit in one packet of max_bytes.
+inline bool framePacketsNeeded(int width, int height, int max_bytes) {
+    return (long)width * height * 3 + FRAME_PACKET_HEADER > max_bytes;
+}
+
+// Splits a width x height frame into the fewest, most even parts that fit in
+// packets of max_bytes.
+inline void planPackets(int width, int height, int max_bytes, std::vector<FramePacket> &packets) {
+    const int max_pixels = (max_bytes - FRAME_PACKET_HEADER) / 3;
+    packets.clear();
+    if (width <= max_pixels) {
+        const int max_rows = max_pixels / width;
+        const int count = (height + max_rows - 1) / max_rows;
+        const int rows = (height + count - 1) / count;
+        for (int y=0; y < height; y += rows) {
+            packets.push_back({ 0, y, width, (height - y < rows) ? height - y : rows, NULL });
+        }
+    }
+    else {
+        const int count = (width + max_pixels - 1) / max_pixels;
+        const int run = (width + count - 1) / count;
+        for (int y=0; y < height; y++) {
+            for (int x=0; x < width; x += run) {
+                packets.push_back({ x, y, (width - x < run) ? width - x : run, 1, NULL });
+            }
+        }
+    }
+}
+
+// Sends frames as the packets planned for their size.
+class FramePacketSender {
+public:
+    FramePacketSender() {}
+    ~FramePacketSender() { Release(); }
+
+    FramePacketSender(const FramePacketSender &) = delete;
+    FramePacketSender &operator=(const FramePacketSender &) = delete;
+
+    // Sends the width x height pixels (packed RGB) at offset x, y on layer z.
+    void Send(int socket, const uint8_t *pixels, int width, int height, int max_bytes,
+              int x, int y, int z) {
+        if (socket != socket_ || width != width_ || height != height_ || max_bytes != max_bytes_) {
+            Release();
+            planPackets(width, height, max_bytes, packets_);
+            for (FramePacket &p : packets_) {
+                p.canvas = new UDPFlaschenTaschen(socket, p.width, p.height);
+            }
+            socket_ = socket;
+            width_ = width;
+            height_ = height;
+            max_bytes_ = max_bytes;
+        }
+        for (FramePacket &p : packets_) {
+            const uint8_t *src = pixels + ((long)p.y * width + p.x) * 3;
+            memcpy((void *)&p.canvas->GetPixel(0, 0), src, p.width * p.height * 3);
+            p.canvas->SetOffset(x + p.x, y + p.y, z);
+            p.canvas->Send();
+        }
+    }
+
+private:
+    void Release() {
+        for (FramePacket &p : packets_) { delete p.canvas; }
+        packets_.clear();
+        width_ = height_ = 0;
+    }
+
+    std::vector<FramePacket> packets_;
+    int socket_ = -1;
+    int width_ = 0, height_ = 0;
+    int max_bytes_ = 0;
+};
+
+#endif  // FRAME_PACKETS_H
@@ -0,0 +1,245 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// ft-async-logger
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Keeps logging off the render thread. AsyncLogger wraps the Logger from
+// ft-logger.h: a call to log() only copies the format string pointer and its
+// arguments into a record in a lock-free ring and returns. A writer thread
+// formats the records and passes them to Logger, which does the file I/O.
+//
+//  AsyncLogger logger("ft-black.log");
+//  logger.log<INFO>("Filling layer {} with RGB({},{},{})", layer, r, g, b);
+//
+// Each {} in the format is replaced by the next argument: integers, doubles
+// (printed like std::to_string()), and strings, which are copied. The format
+// must be a string literal, as only its pointer is kept.
+//
+// Levels below FT_LOG_LEVEL (default INFO) compile to nothing; build with
+// -DFT_LOG_LEVEL=DEBUG to keep the debug messages. If the ring is full the
+// record is dropped rather than waiting for the writer, and the number of
+// dropped records is logged as a warning.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef FT_ASYNC_LOGGER_H
+#define FT_ASYNC_LOGGER_H
+
+#include "ft-logger.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#ifndef FT_LOG_LEVEL
+#define FT_LOG_LEVEL INFO
+#endif
+
+#define ASYNC_LOG_RECORDS 256   // ring size, a power of 2
+#define ASYNC_LOG_ARGS 8        // arguments per record
+#define ASYNC_LOG_TEXT 192      // bytes per record for string arguments
+#define ASYNC_LOG_POLL 20000    // us between writer passes
+
+class AsyncLogger {
+public:
+    explicit AsyncLogger(const std::string &filename)
+        : logger_(filename) {
+        for (uint32_t i=0; i < ASYNC_LOG_RECORDS; i++) {
+            records_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        writer_ = std::thread(&AsyncLogger::WriterLoop, this);
+    }
+
+    ~AsyncLogger() {
+        stop_ = true;
+        writer_.join();
+    }
+
+    // Queues a message for the writer thread. Never blocks.
+    template <LogLevel Level, class... Args>
+    void log(const char *fmt, const Args &... args) {
+        if constexpr (Level >= FT_LOG_LEVEL) {
+            static_assert(sizeof...(Args) <= ASYNC_LOG_ARGS, "too many log arguments");
+            Record *r = Claim();
+            if (!r) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            r->level = Level;
+            r->fmt = fmt;
+            r->nargs = 0;
+            r->text_used = 0;
+            (Capture(*r, args), ...);
+            r->seq.store(r->pos + 1, std::memory_order_release);
+        }
+    }
+
+    // Records dropped so far because the ring was full.
+    long dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Arg {
+        enum Type : uint8_t { INT, UINT, DOUBLE, TEXT } type;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            uint16_t text;          // offset into Record::text
+        };
+    };
+
+    struct Record {
+        std::atomic<uint32_t> seq;  // pos when free, pos + 1 when written
+        uint32_t pos;
+        LogLevel level;
+        const char *fmt;
+        int nargs;
+        int text_used;
+        Arg args[ASYNC_LOG_ARGS];
+        char text[ASYNC_LOG_TEXT];
+    };
+
+    // Bounded multi-producer ring (per-record sequence numbers), so the pipeline
+    // sender or render workers may log too.
+    Record *Claim() {
+        uint32_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Record *r = &records_[pos & (ASYNC_LOG_RECORDS - 1)];
+            const uint32_t seq = r->seq.load(std::memory_order_acquire);
+            const int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    r->pos = pos;
+                    return r;
+                }
+            }
+            else if (diff < 0) {
+                return NULL;        // full
+            }
+            else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <class T>
+    static void Capture(Record &r, const T &value) {
+        Arg &a = r.args[r.nargs++];
+        if constexpr (std::is_floating_point<T>::value) {
+            a.type = Arg::DOUBLE;
+            a.d = value;
+        }
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            a.type = Arg::INT;
+            a.i = value;
+        }
+        else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            a.type = Arg::UINT;
+            a.u = (unsigned long long)value;
+        }
+        else if constexpr (std::is_same<T, std::string>::value) {
+            CaptureText(r, a, value.c_str());
+        }
+        else {
+            CaptureText(r, a, value);   // const char * or char array
+        }
+    }
+
+    // Copies a string into the record, truncated to the space left.
+    static void CaptureText(Record &r, Arg &a, const char *s) {
+        a.type = Arg::TEXT;
+        if (r.text_used >= ASYNC_LOG_TEXT) {
+            a.text = ASYNC_LOG_TEXT - 1;    // no room, the last '\0' gives ""
+            return;
+        }
+        a.text = r.text_used;
+        size_t len = s ? strlen(s) : 0;
+        const size_t room = ASYNC_LOG_TEXT - r.text_used - 1;
+        if (len > room) len = room;
+        if (len > 0) memcpy(r.text + r.text_used, s, len);
+        r.text[r.text_used + len] = '\0';
+        r.text_used += len + 1;
+    }
+
+    static std::string Format(const Record &r) {
+        std::string out;
+        int n = 0;
+        for (const char *p = r.fmt; *p; p++) {
+            if (p[0] == '{' && p[1] == '}' && n < r.nargs) {
+                const Arg &a = r.args[n++];
+                char buf[64];
+                switch (a.type) {
+                case Arg::INT:    snprintf(buf, sizeof(buf), "%lld", a.i); out += buf; break;
+                case Arg::UINT:   snprintf(buf, sizeof(buf), "%llu", a.u); out += buf; break;
+                case Arg::DOUBLE: snprintf(buf, sizeof(buf), "%f", a.d);   out += buf; break;
+                case Arg::TEXT:   out += r.text + a.text; break;
+                }
+                p++;
+            }
+            else {
+                out += *p;
+            }
+        }
+        return out;
+    }
+
+    // Writes everything that is ready. Returns false if the ring was empty.
+    bool Drain() {
+        bool any = false;
+        for (;;) {
+            Record &r = records_[tail_ & (ASYNC_LOG_RECORDS - 1)];
+            if (r.seq.load(std::memory_order_acquire) != tail_ + 1) break;
+            logger_.log(r.level, Format(r));
+            r.seq.store(tail_ + ASYNC_LOG_RECORDS, std::memory_order_release);
+            tail_++;
+            any = true;
+        }
+        const long dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reported_) {
+            logger_.log(WARNING, std::to_string(dropped - reported_) + " log records dropped");
+            reported_ = dropped;
+        }
+        return any;
+    }
+
+    void WriterLoop() {
+        while (!stop_) {
+            if (!Drain()) {
+                usleep(ASYNC_LOG_POLL);
+            }
+        }
+        Drain();
+    }
+
+    Logger logger_;
+    Record records_[ASYNC_LOG_RECORDS];
+    alignas(64) std::atomic<uint32_t> head_{0};
+    alignas(64) uint32_t tail_ = 0;         // writer thread only
+    long reported_ = 0;                     // writer thread only
+    std::atomic<long> dropped_{0};
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+};
+
+#endif  // FT_ASYNC_LOGGER_H
@@ -1,280 +1,280 @@
-// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
-// 
-// hack_font.h
-// Copyright (c) 2016 Carl Gorringe (carl.gorringe.org)
-// https://github.com/cgorringe/ft-demos
-// 5/8/2016
-//
-// This program is free software; you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation version 2.
-//
-// This program is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
-//
-
-#ifndef HACK_FONT_H
-#define HACK_FONT_H
-
-static int hackfont[36][25][4] =
-{
-    {   // -zero-
-        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
-        {-2, 6,-4, 4},{-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},
-        { 2, 4,-2, 4},{-2, 4,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -one-
-        { 1,-2,-1, 0},{-1, 0,-3, 0},{-3, 0, 1,-6},{ 1,-6, 3,-6},{ 3,-6, 3, 6},
-        { 3, 6, 1, 6},{ 1, 6, 1,-2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -two-
-        {-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},
-        { 4,-2,-2, 4},{-2, 4, 4, 4},{ 4, 4, 4, 6},{ 4, 6,-4, 6},{-4, 6,-4, 4},
-        {-4, 4, 2,-2},{ 2,-2, 2,-4},{ 2,-4,-2,-4},{-2,-4,-2,-2},{-2,-2,-4,-2},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -three-
-        {-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},
-        { 4,-2, 2, 0},{ 2, 0, 4, 2},{ 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
-        {-2, 6,-4, 4},{-4, 4,-4, 2},{-4, 2,-2, 2},{-2, 2,-2, 4},{-2, 4, 2, 4},
-        { 2, 4, 2, 2},{ 2, 2, 0, 0},{ 0, 0, 2,-2},{ 2,-2, 2,-4},{ 2,-4,-2,-4},
-        {-2,-4,-2,-2},{-2,-2,-4,-2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -four-
-        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-2},{ 2,-2, 2,-6},{ 2,-6, 4,-6},
-        { 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 0},{ 2, 0,-4, 0},{-4, 0,-4,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -five-
-        { 4,-6,-4,-6},{-4,-6,-4, 0},{-4, 0, 0, 0},{ 0, 0, 2, 2},{ 2, 2, 0, 4},
-        { 0, 4,-4, 4},{-4, 4,-4, 6},{-4, 6, 2, 6},{ 2, 6, 4, 4},{ 4, 4, 4, 0},
-        { 4, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},{ 4,-4, 4,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -six-
-        { 4,-6, 4,-4},{ 4,-4,-2,-4},{-2,-4,-2,-2},{-2,-2, 2,-2},{ 2,-2, 4, 0},
-        { 4, 0, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4,-4},
-        {-4,-4,-2,-6},{-2,-6, 4,-6},{-2, 0, 2, 0},{ 2, 0, 2, 4},{ 2, 4,-2, 4},
-        {-2, 4,-2, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -seven-
-        {-4,-6, 4,-6},{ 4,-6, 4,-4},{ 4,-4, 0, 6},{ 0, 6,-2, 6},{-2, 6, 2,-4},
-        { 2,-4,-4,-4},{-4,-4,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -eight-
-        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},{ 4,-2, 2, 0},{ 2, 0, 4, 2},
-        { 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4, 2},
-        {-4, 2,-2, 0},{-2, 0,-4,-2},{-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},
-        { 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2, 4, 2, 4},{ 2, 4, 2, 2},
-        { 2, 2,-2, 2},{-2, 2,-2, 4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -nine-
-        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
-        {-2, 6,-4, 4},{-4, 4,-4, 2},{-4, 2,-2, 2},{-2, 2,-2, 4},{-2, 4, 2, 4},
-        { 2, 4, 2, 0},{ 2, 0,-2, 0},{-2, 0,-4,-2},{-4,-2,-4,-4},{-4,-4,-2,-6},
-        {-2,-4, 2,-4},{ 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -A-
-        {-2,-6, 2,-6},{ 2,-6, 4,-2},{ 4,-2, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 2},
-        { 2, 2,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-2},{-4,-2,-2,-6},
-        { 0,-4, 2, 0},{ 2, 0,-2, 0},{-2, 0, 0,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -B-
-        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},{ 4,-2, 2, 0},{ 2, 0, 4, 2},
-        { 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-4, 6},{-4, 6,-4,-6},{-2,-4, 2,-4},
-        { 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2, 2, 2, 2},{ 2, 2, 2, 4},
-        { 2, 4,-2, 4},{-2, 4,-2, 2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -C-
-        { 4,-6,-2,-6},{-2,-6,-4,-4},{-4,-4,-4, 4},{-4, 4,-2, 6},{-2, 6, 4, 6},
-        { 4, 6, 4, 4},{ 4, 4, 0, 4},{ 0, 4,-2, 2},{-2, 2,-2,-2},{-2,-2, 0,-4},
-        { 0,-4, 4,-4},{ 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -D-
-        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-4, 6},
-        {-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},{ 2, 4,-2, 4},{-2, 4,-2,-4},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -E-
-        { 4,-6,-4,-6},{-4,-6,-4, 6},{-4, 6, 4, 6},{ 4, 6, 4, 4},{ 4, 4,-2, 4},
-        {-2, 4,-2, 0},{-2, 0, 2, 0},{ 2, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},
-        {-2,-4, 4,-4},{ 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -F-
-        { 4,-6,-4,-6},{-4,-6,-4, 6},{-4, 6,-2, 6},{-2, 6,-2, 0},{-2, 0, 2, 0},
-        { 2, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},{ 4,-4, 4,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -G-
-        { 0, 0, 4, 0},{ 4, 0, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},
-        {-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-6, 4,-6},{ 4,-6, 4,-4},{ 4,-4, 0,-4},
-        { 0,-4,-2,-2},{-2,-2,-2, 2},{-2, 2, 0, 4},{ 0, 4, 2, 4},{ 2, 4, 2, 2},
-        { 2, 2, 0, 2},{ 0, 2, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -H-
-        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-2},{ 2,-2, 2,-6},{ 2,-6, 4,-6},
-        { 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 0},{ 2, 0,-2, 0},{-2, 0,-2, 6},
-        {-2, 6,-4, 6},{-4, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -I-
-        {-1,-6, 1,-6},{ 1,-6, 1, 6},{ 1, 6,-1, 6},{-1, 6,-1,-6},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -J-
-        { 1,-6, 3,-6},{ 3,-6, 3, 4},{ 3, 4, 1, 6},{ 1, 6,-1, 6},{-1, 6,-3, 4},
-        {-3, 4,-3, 2},{-3, 2,-1, 2},{-1, 2,-1, 4},{-1, 4, 1, 4},{ 1, 4, 1,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -K-
-        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 0, 0},
-        { 0, 0, 4, 6},{ 4, 6, 2, 6},{ 2, 6,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},
-        {-4, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -L-
-        {-3,-6,-1,-6},{-1,-6,-1, 4},{-1, 4, 3, 4},{ 3, 4, 3, 6},{ 3, 6,-3, 6},
-        {-3, 6,-3,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -M-
-        {-4,-6, 0,-2},{ 0,-2, 4,-6},{ 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2,-2},
-        { 2,-2, 0, 0},{ 0, 0,-2,-2},{-2,-2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -N-
-        {-3,-6,-1,-6},{-1,-6, 1, 0},{ 1, 0, 1,-6},{ 1,-6, 3,-6},{ 3,-6, 3, 6},
-        { 3, 6, 1, 6},{ 1, 6,-1, 0},{-1, 0,-1, 6},{-1, 6,-3, 6},{-3, 6,-3,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -O-
-        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
-        {-2, 6,-4, 4},{-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},
-        { 2, 4,-2, 4},{-2, 4,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -P-
-        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 0},{ 4, 0, 2, 2},{ 2, 2,-2, 2},
-        {-2, 2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 0},
-        { 2, 0,-2, 0},{-2, 0,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -Q-
-        {-1,-6, 1,-6},{ 1,-6, 3,-4},{ 3,-4, 3, 4},{ 3, 4, 5, 6},{ 5, 6,-1, 6},
-        {-1, 6,-3, 4},{-3, 4,-3,-4},{-3,-4,-1,-6},{-1,-4, 1,-4},{ 1,-4, 1, 4},
-        { 1, 4,-1, 4},{-1, 4,-1,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -R-
-        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 0},{ 4, 0, 2, 2},{ 2, 2, 4, 6},
-        { 4, 6, 2, 6},{ 2, 6, 0, 2},{ 0, 2,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},
-        {-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 0},{ 2, 0,-2, 0},{-2, 0,-2,-4},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -S-
-        { 4,-6,-2,-6},{-2,-6,-4,-4},{-4,-4,-4,-2},{-4,-2,-2, 0},{-2, 0, 2, 0},
-        { 2, 0, 2, 4},{ 2, 4,-4, 4},{-4, 4,-4, 6},{-4, 6, 2, 6},{ 2, 6, 4, 4},
-        { 4, 4, 4, 0},{ 4, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},
-        { 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -T-
-        {-3,-6, 3,-6},{ 3,-6, 3,-4},{ 3,-4, 1,-4},{ 1,-4, 1, 6},{ 1, 6,-1, 6},
-        {-1, 6,-1,-4},{-1,-4,-3,-4},{-3,-4,-3,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -U-
-        {-4,-6,-2,-6},{-2,-6,-2, 4},{-2, 4, 2, 4},{ 2, 4, 2,-6},{ 2,-6, 4,-6},
-        { 4,-6, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -V-
-        {-4,-6,-2,-6},{-2,-6, 0, 4},{ 0, 4, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 2, 6},
-        { 2, 6,-2, 6},{-2, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -W-
-        {-6,-6,-4,-6},{-4,-6,-2, 4},{-2, 4, 0,-2},{ 0,-2, 2, 4},{ 2, 4, 4,-6},
-        { 4,-6, 6,-6},{ 6,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 0, 4},{ 0, 4,-2, 6},
-        {-2, 6,-4, 6},{-4, 6,-6,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -X-
-        {-4,-6,-2,-6},{-2,-6, 0,-2},{ 0,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 2, 0},
-        { 2, 0, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 0, 2},{ 0, 2,-2, 6},{-2, 6,-4, 6},
-        {-4, 6,-2, 0},{-2, 0,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -Y-
-        {-4,-6,-2,-6},{-2,-6, 0,-2},{ 0,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 1, 0},
-        { 1, 0, 1, 6},{ 1, 6,-1, 6},{-1, 6,-1, 0},{-1, 0,-4,-6},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    },
-    {   // -Z-
-        {-3,-6, 3,-6},{ 3,-6, 3,-4},{ 3,-4,-1, 4},{-1, 4, 3, 4},{ 3, 4, 3, 6},
-        { 3, 6,-3, 6},{-3, 6,-3, 4},{-3, 4, 1,-4},{ 1,-4,-3,-4},{-3,-4,-3,-6},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
-        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
-    }
-};
-
-#endif  // HACK_FONT_H
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+// 
+// hack_font.h
+// Copyright (c) 2016 Carl Gorringe (carl.gorringe.org)
+// https://github.com/cgorringe/ft-demos
+// 5/8/2016
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef HACK_FONT_H
+#define HACK_FONT_H
+
+static int hackfont[36][25][4] =
+{
+    {   // -zero-
+        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
+        {-2, 6,-4, 4},{-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},
+        { 2, 4,-2, 4},{-2, 4,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -one-
+        { 1,-2,-1, 0},{-1, 0,-3, 0},{-3, 0, 1,-6},{ 1,-6, 3,-6},{ 3,-6, 3, 6},
+        { 3, 6, 1, 6},{ 1, 6, 1,-2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -two-
+        {-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},
+        { 4,-2,-2, 4},{-2, 4, 4, 4},{ 4, 4, 4, 6},{ 4, 6,-4, 6},{-4, 6,-4, 4},
+        {-4, 4, 2,-2},{ 2,-2, 2,-4},{ 2,-4,-2,-4},{-2,-4,-2,-2},{-2,-2,-4,-2},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -three-
+        {-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},
+        { 4,-2, 2, 0},{ 2, 0, 4, 2},{ 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
+        {-2, 6,-4, 4},{-4, 4,-4, 2},{-4, 2,-2, 2},{-2, 2,-2, 4},{-2, 4, 2, 4},
+        { 2, 4, 2, 2},{ 2, 2, 0, 0},{ 0, 0, 2,-2},{ 2,-2, 2,-4},{ 2,-4,-2,-4},
+        {-2,-4,-2,-2},{-2,-2,-4,-2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -four-
+        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-2},{ 2,-2, 2,-6},{ 2,-6, 4,-6},
+        { 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 0},{ 2, 0,-4, 0},{-4, 0,-4,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -five-
+        { 4,-6,-4,-6},{-4,-6,-4, 0},{-4, 0, 0, 0},{ 0, 0, 2, 2},{ 2, 2, 0, 4},
+        { 0, 4,-4, 4},{-4, 4,-4, 6},{-4, 6, 2, 6},{ 2, 6, 4, 4},{ 4, 4, 4, 0},
+        { 4, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},{ 4,-4, 4,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -six-
+        { 4,-6, 4,-4},{ 4,-4,-2,-4},{-2,-4,-2,-2},{-2,-2, 2,-2},{ 2,-2, 4, 0},
+        { 4, 0, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4,-4},
+        {-4,-4,-2,-6},{-2,-6, 4,-6},{-2, 0, 2, 0},{ 2, 0, 2, 4},{ 2, 4,-2, 4},
+        {-2, 4,-2, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -seven-
+        {-4,-6, 4,-6},{ 4,-6, 4,-4},{ 4,-4, 0, 6},{ 0, 6,-2, 6},{-2, 6, 2,-4},
+        { 2,-4,-4,-4},{-4,-4,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -eight-
+        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},{ 4,-2, 2, 0},{ 2, 0, 4, 2},
+        { 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4, 2},
+        {-4, 2,-2, 0},{-2, 0,-4,-2},{-4,-2,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},
+        { 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2, 4, 2, 4},{ 2, 4, 2, 2},
+        { 2, 2,-2, 2},{-2, 2,-2, 4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -nine-
+        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
+        {-2, 6,-4, 4},{-4, 4,-4, 2},{-4, 2,-2, 2},{-2, 2,-2, 4},{-2, 4, 2, 4},
+        { 2, 4, 2, 0},{ 2, 0,-2, 0},{-2, 0,-4,-2},{-4,-2,-4,-4},{-4,-4,-2,-6},
+        {-2,-4, 2,-4},{ 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -A-
+        {-2,-6, 2,-6},{ 2,-6, 4,-2},{ 4,-2, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 2},
+        { 2, 2,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-2},{-4,-2,-2,-6},
+        { 0,-4, 2, 0},{ 2, 0,-2, 0},{-2, 0, 0,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -B-
+        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4,-2},{ 4,-2, 2, 0},{ 2, 0, 4, 2},
+        { 4, 2, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-4, 6},{-4, 6,-4,-6},{-2,-4, 2,-4},
+        { 2,-4, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2, 2, 2, 2},{ 2, 2, 2, 4},
+        { 2, 4,-2, 4},{-2, 4,-2, 2},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -C-
+        { 4,-6,-2,-6},{-2,-6,-4,-4},{-4,-4,-4, 4},{-4, 4,-2, 6},{-2, 6, 4, 6},
+        { 4, 6, 4, 4},{ 4, 4, 0, 4},{ 0, 4,-2, 2},{-2, 2,-2,-2},{-2,-2, 0,-4},
+        { 0,-4, 4,-4},{ 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -D-
+        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-4, 6},
+        {-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},{ 2, 4,-2, 4},{-2, 4,-2,-4},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -E-
+        { 4,-6,-4,-6},{-4,-6,-4, 6},{-4, 6, 4, 6},{ 4, 6, 4, 4},{ 4, 4,-2, 4},
+        {-2, 4,-2, 0},{-2, 0, 2, 0},{ 2, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},
+        {-2,-4, 4,-4},{ 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -F-
+        { 4,-6,-4,-6},{-4,-6,-4, 6},{-4, 6,-2, 6},{-2, 6,-2, 0},{-2, 0, 2, 0},
+        { 2, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},{ 4,-4, 4,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -G-
+        { 0, 0, 4, 0},{ 4, 0, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},
+        {-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-6, 4,-6},{ 4,-6, 4,-4},{ 4,-4, 0,-4},
+        { 0,-4,-2,-2},{-2,-2,-2, 2},{-2, 2, 0, 4},{ 0, 4, 2, 4},{ 2, 4, 2, 2},
+        { 2, 2, 0, 2},{ 0, 2, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -H-
+        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-2},{ 2,-2, 2,-6},{ 2,-6, 4,-6},
+        { 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2, 0},{ 2, 0,-2, 0},{-2, 0,-2, 6},
+        {-2, 6,-4, 6},{-4, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -I-
+        {-1,-6, 1,-6},{ 1,-6, 1, 6},{ 1, 6,-1, 6},{-1, 6,-1,-6},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -J-
+        { 1,-6, 3,-6},{ 3,-6, 3, 4},{ 3, 4, 1, 6},{ 1, 6,-1, 6},{-1, 6,-3, 4},
+        {-3, 4,-3, 2},{-3, 2,-1, 2},{-1, 2,-1, 4},{-1, 4, 1, 4},{ 1, 4, 1,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -K-
+        {-4,-6,-2,-6},{-2,-6,-2,-2},{-2,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 0, 0},
+        { 0, 0, 4, 6},{ 4, 6, 2, 6},{ 2, 6,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},
+        {-4, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -L-
+        {-3,-6,-1,-6},{-1,-6,-1, 4},{-1, 4, 3, 4},{ 3, 4, 3, 6},{ 3, 6,-3, 6},
+        {-3, 6,-3,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -M-
+        {-4,-6, 0,-2},{ 0,-2, 4,-6},{ 4,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 2,-2},
+        { 2,-2, 0, 0},{ 0, 0,-2,-2},{-2,-2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -N-
+        {-3,-6,-1,-6},{-1,-6, 1, 0},{ 1, 0, 1,-6},{ 1,-6, 3,-6},{ 3,-6, 3, 6},
+        { 3, 6, 1, 6},{ 1, 6,-1, 0},{-1, 0,-1, 6},{-1, 6,-3, 6},{-3, 6,-3,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -O-
+        {-2,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},
+        {-2, 6,-4, 4},{-4, 4,-4,-4},{-4,-4,-2,-6},{-2,-4, 2,-4},{ 2,-4, 2, 4},
+        { 2, 4,-2, 4},{-2, 4,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -P-
+        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 0},{ 4, 0, 2, 2},{ 2, 2,-2, 2},
+        {-2, 2,-2, 6},{-2, 6,-4, 6},{-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 0},
+        { 2, 0,-2, 0},{-2, 0,-2,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -Q-
+        {-1,-6, 1,-6},{ 1,-6, 3,-4},{ 3,-4, 3, 4},{ 3, 4, 5, 6},{ 5, 6,-1, 6},
+        {-1, 6,-3, 4},{-3, 4,-3,-4},{-3,-4,-1,-6},{-1,-4, 1,-4},{ 1,-4, 1, 4},
+        { 1, 4,-1, 4},{-1, 4,-1,-4},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -R-
+        {-4,-6, 2,-6},{ 2,-6, 4,-4},{ 4,-4, 4, 0},{ 4, 0, 2, 2},{ 2, 2, 4, 6},
+        { 4, 6, 2, 6},{ 2, 6, 0, 2},{ 0, 2,-2, 2},{-2, 2,-2, 6},{-2, 6,-4, 6},
+        {-4, 6,-4,-6},{-2,-4, 2,-4},{ 2,-4, 2, 0},{ 2, 0,-2, 0},{-2, 0,-2,-4},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -S-
+        { 4,-6,-2,-6},{-2,-6,-4,-4},{-4,-4,-4,-2},{-4,-2,-2, 0},{-2, 0, 2, 0},
+        { 2, 0, 2, 4},{ 2, 4,-4, 4},{-4, 4,-4, 6},{-4, 6, 2, 6},{ 2, 6, 4, 4},
+        { 4, 4, 4, 0},{ 4, 0, 2,-2},{ 2,-2,-2,-2},{-2,-2,-2,-4},{-2,-4, 4,-4},
+        { 4,-4, 4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -T-
+        {-3,-6, 3,-6},{ 3,-6, 3,-4},{ 3,-4, 1,-4},{ 1,-4, 1, 6},{ 1, 6,-1, 6},
+        {-1, 6,-1,-4},{-1,-4,-3,-4},{-3,-4,-3,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -U-
+        {-4,-6,-2,-6},{-2,-6,-2, 4},{-2, 4, 2, 4},{ 2, 4, 2,-6},{ 2,-6, 4,-6},
+        { 4,-6, 4, 4},{ 4, 4, 2, 6},{ 2, 6,-2, 6},{-2, 6,-4, 4},{-4, 4,-4,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -V-
+        {-4,-6,-2,-6},{-2,-6, 0, 4},{ 0, 4, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 2, 6},
+        { 2, 6,-2, 6},{-2, 6,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -W-
+        {-6,-6,-4,-6},{-4,-6,-2, 4},{-2, 4, 0,-2},{ 0,-2, 2, 4},{ 2, 4, 4,-6},
+        { 4,-6, 6,-6},{ 6,-6, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 0, 4},{ 0, 4,-2, 6},
+        {-2, 6,-4, 6},{-4, 6,-6,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -X-
+        {-4,-6,-2,-6},{-2,-6, 0,-2},{ 0,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 2, 0},
+        { 2, 0, 4, 6},{ 4, 6, 2, 6},{ 2, 6, 0, 2},{ 0, 2,-2, 6},{-2, 6,-4, 6},
+        {-4, 6,-2, 0},{-2, 0,-4,-6},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -Y-
+        {-4,-6,-2,-6},{-2,-6, 0,-2},{ 0,-2, 2,-6},{ 2,-6, 4,-6},{ 4,-6, 1, 0},
+        { 1, 0, 1, 6},{ 1, 6,-1, 6},{-1, 6,-1, 0},{-1, 0,-4,-6},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    },
+    {   // -Z-
+        {-3,-6, 3,-6},{ 3,-6, 3,-4},{ 3,-4,-1, 4},{-1, 4, 3, 4},{ 3, 4, 3, 6},
+        { 3, 6,-3, 6},{-3, 6,-3, 4},{-3, 4, 1,-4},{ 1,-4,-3,-4},{-3,-4,-3,-6},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},
+        { 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0},{ 0, 0, 0, 0}
+    }
+};
+
+#endif  // HACK_FONT_H
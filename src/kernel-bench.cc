@@ -0,0 +1,648 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// kernel-bench
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+// 18/10/2026 - Added generic versions of the size-templated kernels.
+// 18/10/2026 - Added -j to set the number of render threads.
+// 18/10/2026 - Added the output stage color correction and dithering.
+// 18/10/2026 - Added the output stage remap.
+// 18/10/2026 - kernel-bench buffers are aligned PixelBuffers like the demos'.
+// 18/10/2026 - The plasma benchmark uses Q16.16 tables like plasma.cc.
+// 18/10/2026 - Uses initPlasmaTables() and the table trig like plasma.cc; added
+// fastSinBatch against libm sinf().
+// 18/10/2026 - Added the clipped line and polygon fill from raster.h.
+// 18/10/2026 - Added the effect stack from effects.h.
+// 18/10/2026 - Added int16 and float heat stencils from stencil.h.
+// 18/10/2026 - Added the palette copy into an RGBX surface and its pack to
+// RGB bytes (surface.h).
+//
+// Microbenchmarks for the hot inner loops in demo-kernels.h. Each kernel is
+// warmed up, then timed over a number of repetitions, and the per-call time
+// is summarized as min / median / mean / standard deviation.
+//
+// Results can be saved as a baseline file and later runs compared against it;
+// any kernel whose median got slower by more than the threshold is flagged
+// and the program exits with status 2.
+//
+// How to run:
+//
+// To see command line options:
+//  ./kernel-bench -?
+//
+//  ./kernel-bench -s bench-baseline.txt        (record a baseline)
+//  ./kernel-bench -b bench-baseline.txt -T 5   (compare, flag > 5% slower)
+//  ./kernel-bench -g 45x35 -k blur             (only kernels matching 'blur')
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#include "udp-flaschen-taschen.h"
+#include "config.h"
+#include "demo-kernels.h"
+#include "output-stage.h"
+#include "raster.h"
+#include "effects.h"
+#include "surface.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Defaults
+#define WARMUP 20          // untimed calls before measuring
+#define REPEAT 15          // timed repetitions
+#define MIN_REP_NSEC 5000000LL  // each repetition runs for at least 5ms
+#define THRESHOLD 10.0     // percent slower than baseline to flag
+
+// ------------------------------------------------------------------------------------------
+// Command Line Options
+
+// option vars
+int opt_width  = DISPLAY_WIDTH;
+int opt_height = DISPLAY_HEIGHT;
+int opt_warmup = WARMUP;
+int opt_repeat = REPEAT;
+double opt_threshold = THRESHOLD;
+const char *opt_filter = NULL;
+const char *opt_baseline = NULL;
+const char *opt_save = NULL;
+
+int usage(const char *progname) {
+
+    fprintf(stderr, "Kernel Bench (c) 2026 James Crowley (judgejc.net)\n");
+    fprintf(stderr, "Usage: %s [options]\n", progname);
+    fprintf(stderr, "Options:\n"
+        "\t-g <W>x<H>     : Geometry to benchmark. (default 64x64)\n"
+        "\t-w <count>     : Warmup calls per kernel. (default 20)\n"
+        "\t-r <count>     : Timed repetitions per kernel. (default 15)\n"
+        "\t-k <name>      : Only run kernels whose name contains <name>.\n"
+        "\t-s <file>      : Save results as baseline file.\n"
+        "\t-b <file>      : Compare against baseline file.\n"
+        "\t-T <percent>   : Regression threshold in percent. (default 10)\n"
+        "\t-j <threads>   : Render threads. (FT_THREADS, default all CPUs)\n"
+    );
+    return 1;
+}
+
+int cmdLine(int argc, char *argv[]) {
+
+    // command line options
+    int opt;
+    while ((opt = getopt(argc, argv, "?g:w:r:k:s:b:T:j:")) != -1) {
+        switch (opt) {
+        case '?':  // help
+            return usage(argv[0]);
+            break;
+        case 'g':  // geometry
+            if (sscanf(optarg, "%dx%d", &opt_width, &opt_height) != 2 || opt_width < 2 || opt_height < 1) {
+                fprintf(stderr, "Invalid size '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'w':  // warmup
+            if (sscanf(optarg, "%d", &opt_warmup) != 1 || opt_warmup < 0) {
+                fprintf(stderr, "Invalid warmup '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'r':  // repetitions
+            if (sscanf(optarg, "%d", &opt_repeat) != 1 || opt_repeat < 1) {
+                fprintf(stderr, "Invalid repetitions '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'k':  // kernel filter
+            opt_filter = strdup(optarg); // leaking. Ignore.
+            break;
+        case 's':  // save baseline
+            opt_save = strdup(optarg); // leaking. Ignore.
+            break;
+        case 'b':  // compare baseline
+            opt_baseline = strdup(optarg); // leaking. Ignore.
+            break;
+        case 'T':  // threshold
+            if (sscanf(optarg, "%lf", &opt_threshold) != 1 || opt_threshold < 0) {
+                fprintf(stderr, "Invalid threshold '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        case 'j':  // threads
+            if (sscanf(optarg, "%d", &thread_pool_threads) != 1 || thread_pool_threads < 1) {
+                fprintf(stderr, "Invalid threads '%s'\n", optarg);
+                return usage(argv[0]);
+            }
+            break;
+        default:
+            return usage(argv[0]);
+        }
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------
+// Bench state shared by all kernels
+
+struct BenchState {
+    int width, height;
+    PixelBuffer<uint8_t> pristine;    // random input, restored before stateful kernels
+    PixelBuffer<uint8_t> life;        // random 0/1 cells
+    PixelBuffer<uint8_t> pixels;      // working index buffer
+    PixelBuffer<uint8_t> super;       // 4x4 supersampled index buffer (plasma2)
+    PixelBuffer<Color> colors;
+    Surface surface;                  // render surface, as DemoCanvas'
+    Color palette[256];
+    uint8_t lut[3][256];
+    uint16_t lut16[3][256];
+    std::vector<int32_t> remap;
+    std::vector<uint8_t> dither_error;
+    FractalState frac;
+    Buffer2D<Q16_16> *plasma1, *plasma2, *plasma_pixels;
+    std::vector<float> angles, sines;   // one per pixel, radians
+    int lookup_quant;
+    int count;
+    UDPFlaschenTaschen *canvas;
+    volatile uint32_t sink;           // keeps results alive
+};
+
+static int64_t nowNsec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void restorePixels(BenchState &s) {
+    memcpy(s.pixels.data(), s.pristine.data(), s.pixels.size());
+}
+
+static void restoreLife(BenchState &s) {
+    memcpy(s.pixels.data(), s.life.data(), s.pixels.size());
+}
+
+static void benchBlur3(BenchState &s) {
+    blur3(s.width, s.height, s.pixels.data());
+}
+
+// the same blur and drop as an effect stack, as hack runs it
+static void benchEffectBlur(BenchState &s) {
+    static EffectStack fx;
+    std::string error;
+    if (fx.empty()) fx.Parse("blur,decay:8", &error);
+    fx.Apply(s.pixels);
+}
+
+static void benchEffectGlow(BenchState &s) {
+    static EffectStack fx;
+    std::string error;
+    if (fx.empty()) fx.Parse("glow:96:64,trails:224", &error);
+    fx.Apply(s.pixels);
+}
+
+static void benchEffectGlowRgb(BenchState &s) {
+    static EffectStack fx;
+    std::string error;
+    if (fx.empty()) fx.Parse("glow:96:64,trails:224", &error);
+    fx.Apply(s.colors);
+}
+
+static void benchEffectZoom(BenchState &s) {
+    static EffectStack fx;
+    std::string error;
+    if (fx.empty()) fx.Parse("zoom:105,decay:2", &error);
+    fx.Apply(s.pixels);
+}
+
+// heat spreading to the four neighbours, for the wider cell types of stencil.h
+struct HeatKernel16 {
+    inline int16_t operator()(const StencilCells<int16_t> &n) const {
+        return (int16_t)((4 * n.c + n.n + n.w + n.e + n.s) >> 3);
+    }
+};
+
+struct HeatKernelFloat {
+    inline float operator()(const StencilCells<float> &n) const {
+        return n.c + 0.2f * (n.n + n.w + n.e + n.s - 4 * n.c);
+    }
+};
+
+template <class T, class Kernel>
+static void benchHeat(BenchState &s) {
+    static StencilBuffers<T> heat(s.width, s.height);
+    if (s.count++ % 64 == 0) {
+        for (int i=0; i < s.width * s.height; i++) { heat.front()[i] = (T)s.pristine[i]; }
+    }
+    heat.Step(STENCIL_CLAMP, Kernel());
+}
+
+static void benchFireUp(BenchState &s) {
+    blurFire(s.width, s.height, s.pixels.data());
+}
+
+static void benchLife(BenchState &s) {
+    runGameOfLife(s.width, s.height, s.pixels.data());
+}
+
+static void benchMatrix(BenchState &s) {
+    runMatrix(s.width, s.height, 8, s.pixels.data());
+}
+
+// generic (runtime size) versions, to compare against the sized dispatch above
+static void benchBlur3Generic(BenchState &s) {
+    blur3Sized<0, 0>(s.width, s.height, s.pixels.data());
+}
+
+static void benchFireUpGeneric(BenchState &s) {
+    blurFireSized<0, 0>(s.width, s.height, s.pixels.data());
+}
+
+static void benchLifeGeneric(BenchState &s) {
+    runGameOfLifeSized<0, 0>(s.width, s.height, s.pixels.data());
+}
+
+static void benchMatrixGeneric(BenchState &s) {
+    runMatrixSized<0, 0>(s.width, s.height, 8, s.pixels.data());
+}
+
+// one complete fractal at 2x resolution, which fractal.cc computes a few
+// lines a frame; computeFractal() does scale1 lines a call
+static void benchComputeFractal(BenchState &s) {
+    const double zx = 0.0625, zy = 0.0625;
+    const long size = (long)s.frac.width * s.frac.scale1 * s.frac.height * s.frac.scale1;
+    startFractal(s.frac, -0.577816 - zx, -0.631121 - zy, -0.577816 + zx, -0.631121 + zy);
+    while (s.frac.offs + 1 < size) { computeFractal(s.frac); }
+    s.sink += s.frac.frac1[s.frac.offs / 2];
+}
+
+static void benchZoomFractal(BenchState &s) {
+    s.count++;
+    zoomFractal(s.frac, (double)(s.count % 128) / 128.0, s.pixels.data());
+    s.sink += s.pixels[s.count % s.pixels.size()];
+}
+
+static void benchPlasma(BenchState &s) {
+    // same window movement as plasma.cc at the default delay
+    const int hw = s.lookup_quant * s.width / 2;
+    const int hh = s.lookup_quant * s.height / 2;
+    const float slowness = 100.0 / 25;
+    const int count = s.count++;
+    int x1 = hw + (fastCos(trigPhase( count /  97.0 / slowness )) * hw).round();
+    int x2 = hw + (fastSin(trigPhase(-count / 114.0 / slowness )) * hw).round();
+    int x3 = hw + (fastSin(trigPhase(-count / 137.0 / slowness )) * hw).round();
+    int y1 = hh + (fastSin(trigPhase( count / 123.0 / slowness )) * hh).round();
+    int y2 = hh + (fastCos(trigPhase(-count /  75.0 / slowness )) * hh).round();
+    int y3 = hh + (fastCos(trigPhase(-count / 108.0 / slowness )) * hh).round();
+    Q16_16 lowest = Q16_16::fromInt(100), highest = Q16_16::fromInt(-100);
+    samplePlasma(*s.plasma1, *s.plasma2, x1, y1, x2, y2, x3, y3, s.lookup_quant,
+                 *s.plasma_pixels, &lowest, &highest);
+    normalizePlasma(*s.plasma_pixels, lowest, highest, s.pixels.data());
+    s.sink += s.pixels[0];
+}
+
+static void benchSinBatch(BenchState &s) {
+    fastSinBatch(s.angles.data(), s.sines.data(), (int)s.angles.size());
+    s.sink += (uint32_t)(s.sines[s.count++ % s.sines.size()] * 255);
+}
+
+// the same with libm, for comparison
+static void benchSinLibm(BenchState &s) {
+    for (size_t i=0; i < s.angles.size(); i++) {
+        s.sines[i] = sinf(s.angles[i]);
+    }
+    s.sink += (uint32_t)(s.sines[s.count++ % s.sines.size()] * 255);
+}
+
+static void benchDownsample(BenchState &s) {
+    downsample4x4(s.super.data(), s.palette, s.width, s.height, s.colors.data());
+    s.sink += s.colors[0].r;
+}
+
+// a fan of 16 anti-aliased lines through the canvas
+static void benchDrawLine2(BenchState &s) {
+    const int w = s.width - 1, h = s.height - 1;
+    for (int i=0; i < 8; i++) {
+        drawLine2(i * w / 8, 0, w - i * w / 8, h, Color(255, 127, 63), *s.canvas);
+        drawLine2(0, i * h / 8, w, h - i * h / 8, Color(63, 127, 255), *s.canvas);
+    }
+}
+
+// the same fan in the index buffer, running off the edges so it's clipped
+static void benchRasterLine(BenchState &s) {
+    Raster<uint8_t> r(s.pixels);
+    const int w = s.width - 1, h = s.height - 1;
+    for (int i=0; i < 8; i++) {
+        rasterLine(r, i * w / 4 - w / 2, -h / 2, w + w / 2 - i * w / 4, h + h / 2, (uint8_t)0xFF);
+        rasterLine(r, -w / 2, i * h / 4 - h / 2, w + w / 2, h + h / 2 - i * h / 4, (uint8_t)0x80);
+    }
+}
+
+// a star, half off the canvas
+static void benchRasterPolygon(BenchState &s) {
+    Raster<uint8_t> r(s.pixels);
+    const int w = s.width, h = s.height;
+    const RasterPoint star[5] = {
+        { w / 2, -h / 4 }, { w + w / 4, h + h / 4 }, { -w / 4, h / 3 },
+        { w + w / 4, h / 3 }, { -w / 4, h + h / 4 },
+    };
+    rasterFillPolygon(r, star, 5, (uint8_t)0xFF);
+}
+
+static void benchPaletteCopy(BenchState &s) {
+    copyPalettePixels(s.pristine.data(), s.palette, s.width, s.height, *s.canvas);
+}
+
+static void benchPaletteSurface(BenchState &s) {
+    copyPalettePixels(s.pristine.data(), s.palette, s.width, s.height, s.surface);
+}
+
+// a frame of the surface to the RGB bytes sent, as DemoCanvas::Send()
+static void benchPackRgb24(BenchState &s) {
+    packRgb24(s.surface.data(), (uint8_t *)&s.canvas->GetPixel(0, 0), s.surface.size());
+}
+
+// gamma 2.2 with the color buffer as a full frame of random pixels
+static void benchColorLut(BenchState &s) {
+    uint8_t *dst = (uint8_t *)&s.canvas->GetPixel(0, 0);
+    applyColorLut(s.lut, (const uint8_t *)s.colors.data(), dst, s.width * s.height);
+}
+
+static void benchDither(BenchState &s) {
+    uint8_t *dst = (uint8_t *)&s.canvas->GetPixel(0, 0);
+    applyDitherLut(s.lut16, (const uint8_t *)s.colors.data(), dst, s.dither_error.data(),
+                   s.width * s.height);
+}
+
+// the output stage's panel remap, here a rotation by 90 degrees
+static void benchRemap(BenchState &s) {
+    uint8_t *dst = (uint8_t *)&s.canvas->GetPixel(0, 0);
+    applyRemap(s.remap.data(), (const uint8_t *)s.colors.data(), dst, s.width * s.height);
+}
+
+struct Kernel {
+    const char *name;
+    void (*setup)(BenchState &);  // untimed, before every call; may be NULL
+    void (*run)(BenchState &);
+};
+
+static const Kernel kKernels[] = {
+    { "blur3",              restorePixels, benchBlur3 },
+    { "blurFire/up",        restorePixels, benchFireUp },
+    { "effects/blur,decay", restorePixels, benchEffectBlur },
+    { "effects/glow",       restorePixels, benchEffectGlow },
+    { "effects/glow/rgb",   NULL,          benchEffectGlowRgb },
+    { "effects/zoom",       restorePixels, benchEffectZoom },
+    { "runGameOfLife",      restoreLife,   benchLife },
+    { "runMatrix",          restorePixels, benchMatrix },
+    { "stencil/heat/int16", NULL,          benchHeat<int16_t, HeatKernel16> },
+    { "stencil/heat/float", NULL,          benchHeat<float, HeatKernelFloat> },
+    { "blur3/generic",      restorePixels, benchBlur3Generic },
+    { "blurFire/up/generic", restorePixels, benchFireUpGeneric },
+    { "runGameOfLife/generic", restoreLife, benchLifeGeneric },
+    { "runMatrix/generic",  restorePixels, benchMatrixGeneric },
+    { "computeFractal",     NULL,          benchComputeFractal },
+    { "zoomFractal",        NULL,          benchZoomFractal },
+    { "plasma/sample",      NULL,          benchPlasma },
+    { "plasma2/downsample", NULL,          benchDownsample },
+    { "fastSinBatch",       NULL,          benchSinBatch },
+    { "fastSinBatch/libm",  NULL,          benchSinLibm },
+    { "drawLine2",          NULL,          benchDrawLine2 },
+    { "rasterLine",         NULL,          benchRasterLine },
+    { "rasterFillPolygon",  NULL,          benchRasterPolygon },
+    { "paletteCopy",        NULL,          benchPaletteCopy },
+    { "paletteCopy/surface", NULL,         benchPaletteSurface },
+    { "surface/packRgb24",  NULL,          benchPackRgb24 },
+    { "output/colorLut",    NULL,          benchColorLut },
+    { "output/dither",      NULL,          benchDither },
+    { "output/remap",       NULL,          benchRemap },
+};
+
+// ------------------------------------------------------------------------------------------
+// Timing & statistics
+
+struct Result {
+    std::string name;
+    double min, median, mean, stddev;  // nsec per call
+    double baseline;                    // nsec per call, < 0 if none
+};
+
+// Time n calls of the kernel, returns total nsec.
+static int64_t timeCalls(const Kernel &k, BenchState &s, int n) {
+    if (!k.setup) {
+        const int64_t start = nowNsec();
+        for (int i=0; i < n; i++) { k.run(s); }
+        return nowNsec() - start;
+    }
+    int64_t total = 0;
+    for (int i=0; i < n; i++) {
+        k.setup(s);
+        const int64_t start = nowNsec();
+        k.run(s);
+        total += nowNsec() - start;
+    }
+    return total;
+}
+
+static Result runKernel(const Kernel &k, BenchState &s) {
+
+    // warmup
+    for (int i=0; i < opt_warmup; i++) {
+        if (k.setup) { k.setup(s); }
+        k.run(s);
+    }
+
+    // calibrate calls per repetition
+    int calls = 1;
+    while (calls < (1 << 20) && timeCalls(k, s, calls) < MIN_REP_NSEC / 4) {
+        calls *= 2;
+    }
+    calls *= 4;
+
+    std::vector<double> samples;
+    for (int r=0; r < opt_repeat; r++) {
+        samples.push_back((double)timeCalls(k, s, calls) / calls);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result res;
+    res.name = k.name;
+    res.min = samples.front();
+    const size_t n = samples.size();
+    res.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    double sum = 0;
+    for (size_t i=0; i < n; i++) { sum += samples[i]; }
+    res.mean = sum / n;
+    double var = 0;
+    for (size_t i=0; i < n; i++) { var += (samples[i] - res.mean) * (samples[i] - res.mean); }
+    res.stddev = (n > 1) ? sqrt(var / (n - 1)) : 0;
+    res.baseline = -1;
+    return res;
+}
+
+// ------------------------------------------------------------------------------------------
+// Baseline file
+//
+// One kernel per line: <name> <W>x<H> <median nsec per call>
+// Lines starting with '#' are comments.
+
+static void loadBaseline(const char *filename, std::vector<Result> &results) {
+
+    FILE *f = fopen(filename, "r");
+    if (!f) {
+        fprintf(stderr, "Couldn't read baseline '%s'\n", filename);
+        return;
+    }
+    char line[256], name[128];
+    int w, h;
+    double median;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%127s %dx%d %lf", name, &w, &h, &median) != 4) continue;
+        if (w != opt_width || h != opt_height) continue;
+        for (size_t i=0; i < results.size(); i++) {
+            if (results[i].name == name) { results[i].baseline = median; }
+        }
+    }
+    fclose(f);
+}
+
+static bool saveBaseline(const char *filename, const std::vector<Result> &results) {
+
+    FILE *f = fopen(filename, "w");
+    if (!f) {
+        fprintf(stderr, "Couldn't write baseline '%s'\n", filename);
+        return false;
+    }
+    fprintf(f, "# kernel-bench baseline: <kernel> <geometry> <median nsec per call>\n");
+    for (size_t i=0; i < results.size(); i++) {
+        fprintf(f, "%s %dx%d %.1f\n", results[i].name.c_str(), opt_width, opt_height, results[i].median);
+    }
+    fclose(f);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+
+    // parse command line
+    if (int e = cmdLine(argc, argv)) { return e; }
+
+    srandom(1);  // same inputs on every run
+
+    BenchState s;
+    s.width = opt_width;
+    s.height = opt_height;
+    const int size = opt_width * opt_height;
+    s.pristine.Resize(opt_width, opt_height);
+    s.life.Resize(opt_width, opt_height);
+    s.pixels.Resize(opt_width, opt_height);
+    s.colors.Resize(opt_width, opt_height);
+    s.surface.Resize(opt_width, opt_height);
+    for (int i=0; i < size; i++) {
+        s.pristine[i] = random() & 0xFF;
+        s.life[i] = (random() % 6) ? 0 : 1;
+    }
+    s.super.Resize(opt_width * 4, opt_height * 4);
+    for (size_t i=0; i < s.super.size(); i++) { s.super[i] = random() & 0xFF; }
+    for (int i=0; i < 256; i++) { s.palette[i] = Color(i, 255 - i, (i * 7) & 0xFF); }
+    for (int i=0; i < size; i++) { s.colors[i] = s.palette[random() & 0xFF]; }
+    blitColors(s.colors.data(), s.surface.data(), size);
+    ColorCorrection cc;
+    cc.gamma = 2.2f;
+    buildColorLut(cc, s.lut);
+    buildColorLut16(cc, s.lut16);
+    s.dither_error.resize(size * 3);
+    initDitherError(s.dither_error.data(), opt_width, opt_height);
+    OutputRemap remap;
+    remap.rotate = 90;
+    buildRemapTable(remap, opt_width, opt_height, s.remap);
+    s.count = 0;
+    s.sink = 0;
+
+    // fractal buffers, seeded with one complete frame for zoomFractal
+    s.frac.width = opt_width;
+    s.frac.height = opt_height;
+    PixelBuffer<uint8_t> frac1(opt_width * 2, opt_height * 2), frac2(opt_width * 2, opt_height * 2);
+    PixelBuffer<double> frac_re(opt_width * 2, 1);
+    s.frac.frac1 = frac1;
+    s.frac.frac2 = frac2;
+    s.frac.re = frac_re;
+    benchComputeFractal(s);
+    finishFractal(s.frac);
+
+    // plasma lookup tables, as in plasma.cc
+    s.lookup_quant = 20;
+    s.plasma1 = new Buffer2D<Q16_16>(s.lookup_quant * opt_width * 2, s.lookup_quant * opt_height * 2);
+    s.plasma2 = new Buffer2D<Q16_16>(s.lookup_quant * opt_width * 2, s.lookup_quant * opt_height * 2);
+    s.plasma_pixels = new Buffer2D<Q16_16>(opt_width, opt_height);
+    initPlasmaTables(*s.plasma1, *s.plasma2, s.lookup_quant);
+
+    // angles for the trig batches, spread over a few turns
+    s.angles.resize((size_t)opt_width * opt_height);
+    s.sines.resize(s.angles.size());
+    for (size_t i=0; i < s.angles.size(); i++) {
+        s.angles[i] = (float)i * 0.0123f - 20.0f;
+    }
+
+    // canvas that is never sent
+    s.canvas = new UDPFlaschenTaschen(-1, opt_width, opt_height);
+
+    // run all kernels
+    std::vector<Result> results;
+    for (size_t i=0; i < sizeof(kKernels) / sizeof(kKernels[0]); i++) {
+        if (opt_filter && !strstr(kKernels[i].name, opt_filter)) continue;
+        results.push_back(runKernel(kKernels[i], s));
+    }
+
+    if (opt_baseline) { loadBaseline(opt_baseline, results); }
+
+    // report
+    int regressions = 0;
+    printf("%-20s %9s %11s %11s %9s %11s %11s\n",
+           "kernel", "geometry", "median(us)", "mean(us)", "stddev%", "min(us)", "vs base");
+    for (size_t i=0; i < results.size(); i++) {
+        const Result &r = results[i];
+        char geometry[32];
+        snprintf(geometry, sizeof(geometry), "%dx%d", opt_width, opt_height);
+        printf("%-20s %9s %11.3f %11.3f %8.1f%% %11.3f",
+               r.name.c_str(), geometry, r.median / 1000, r.mean / 1000,
+               (r.mean > 0) ? 100 * r.stddev / r.mean : 0, r.min / 1000);
+        if (r.baseline > 0) {
+            const double change = 100 * (r.median - r.baseline) / r.baseline;
+            printf(" %+10.1f%%", change);
+            if (change > opt_threshold) {
+                printf("  REGRESSION");
+                regressions++;
+            }
+        }
+        printf("\n");
+    }
+
+    if (opt_save && !saveBaseline(opt_save, results)) { return 1; }
+
+    if (regressions > 0) {
+        fprintf(stderr, "%d kernel(s) regressed more than %.1f%%\n", regressions, opt_threshold);
+        return 2;
+    }
+    return 0;
+}
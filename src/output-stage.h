@@ -0,0 +1,307 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// output-stage
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version, color correction.
+// 18/10/2026 - Added temporal dithering.
+// 18/10/2026 - Added fades.
+// 18/10/2026 - Added the panel remap.
+// 18/10/2026 - Added frame interpolation.
+//
+// Processing applied by DemoCanvas to every frame just before it is sent,
+// after the demo has finished drawing. The demo's own canvas is left alone,
+// so demos that read back their pixels are not affected.
+//
+// Color correction maps each channel through a 256 entry table that combines
+// gamma, brightness, white balance and a per-channel current limit, so the
+// demos do no per-pixel float work for it:
+//
+//  out = min(255 * brightness * white[c] * (in / 255)^gamma, 255 * max_level)
+//
+// Temporal dithering keeps the corrected value in 8.8 fixed point instead of
+// rounding it. Each subpixel carries the fraction that didn't fit in 8 bits
+// over to the next frame, so over a few frames the LEDs average out to the
+// exact level. Dark gradients and slow fades then don't band. The carried
+// error starts from an ordered pattern so that neighbouring pixels of the
+// same color don't step up on the same frame.
+//
+// Fades scale the whole frame by a level from 0 to 1 worked out from the demo
+// clock on every frame sent. The level is a 16.16 fixed point factor folded
+// into the tables, so fading costs a table rebuild per frame (768 entries)
+// rather than any work per pixel, and runs at whatever rate the demo sends.
+//
+// The remap turns the demo's canvas into the layout of the panels it is sent
+// to: rotated, mirrored, cut into a chain of panels and/or with every other
+// row reversed for serpentine wiring. The layout is compiled once into a table
+// holding, for every output pixel, the canvas pixel shown there, so the demos
+// always draw upright and applying it is one gather per pixel.
+//
+// Frame interpolation makes up the frames between two that the demo rendered
+// by blending them, so a demo can render at a half or a third of the frame
+// rate while the display keeps it. It runs before the other stages, which
+// then treat the blended frames like any other.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef OUTPUT_STAGE_H
+#define OUTPUT_STAGE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------
+// Color Correction
+
+struct ColorCorrection {
+    float gamma = 1.0f;
+    float brightness = 1.0f;            // 0.0 to 1.0
+    float white[3] = { 1.0f, 1.0f, 1.0f };  // white balance, per channel 0.0 to 1.0
+    float max_level = 1.0f;             // current limit, per channel 0.0 to 1.0
+
+    bool identity() const {
+        return gamma == 1.0f && brightness == 1.0f && max_level == 1.0f
+            && white[0] == 1.0f && white[1] == 1.0f && white[2] == 1.0f;
+    }
+};
+
+inline void buildColorLut(const ColorCorrection &cc, uint8_t lut[3][256]) {
+    const double limit = 255.0 * cc.max_level;
+    for (int c=0; c < 3; c++) {
+        const double scale = 255.0 * cc.brightness * cc.white[c];
+        for (int v=0; v < 256; v++) {
+            double out = scale * pow(v / 255.0, cc.gamma);
+            if (out > limit) out = limit;
+            lut[c][v] = (uint8_t)lround(out);
+        }
+    }
+}
+
+// Maps npixels RGB pixels from src to dst through lut. src and dst may be
+// the same buffer.
+inline void applyColorLut(const uint8_t lut[3][256], const uint8_t *src, uint8_t *dst, int npixels) {
+    const uint8_t *lr = lut[0], *lg = lut[1], *lb = lut[2];
+    int i = 0;
+    // four pixels per round, so the loads of one don't wait on the stores of another
+    for (; i + 4 <= npixels; i += 4, src += 12, dst += 12) {
+        const uint8_t r0 = lr[src[0]], g0 = lg[src[1]],  b0 = lb[src[2]];
+        const uint8_t r1 = lr[src[3]], g1 = lg[src[4]],  b1 = lb[src[5]];
+        const uint8_t r2 = lr[src[6]], g2 = lg[src[7]],  b2 = lb[src[8]];
+        const uint8_t r3 = lr[src[9]], g3 = lg[src[10]], b3 = lb[src[11]];
+        dst[0] = r0; dst[1]  = g0; dst[2]  = b0;
+        dst[3] = r1; dst[4]  = g1; dst[5]  = b1;
+        dst[6] = r2; dst[7]  = g2; dst[8]  = b2;
+        dst[9] = r3; dst[10] = g3; dst[11] = b3;
+    }
+    for (; i < npixels; i++, src += 3, dst += 3) {
+        dst[0] = lr[src[0]];
+        dst[1] = lg[src[1]];
+        dst[2] = lb[src[2]];
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Temporal Dithering
+
+// Same as buildColorLut() but in 8.8 fixed point, 0 to 0xFF00.
+inline void buildColorLut16(const ColorCorrection &cc, uint16_t lut[3][256]) {
+    const double limit = 255.0 * 256.0 * cc.max_level;
+    for (int c=0; c < 3; c++) {
+        const double scale = 255.0 * 256.0 * cc.brightness * cc.white[c];
+        for (int v=0; v < 256; v++) {
+            double out = scale * pow(v / 255.0, cc.gamma);
+            if (out > limit) out = limit;
+            lut[c][v] = (uint16_t)lround(out);
+        }
+    }
+}
+
+// Seeds the per-subpixel error of a width x height frame with an 8x8 Bayer
+// pattern.
+inline void initDitherError(uint8_t *error, int width, int height) {
+    static const uint8_t bayer[8][8] = {
+        {  0, 32,  8, 40,  2, 34, 10, 42 },
+        { 48, 16, 56, 24, 50, 18, 58, 26 },
+        { 12, 44,  4, 36, 14, 46,  6, 38 },
+        { 60, 28, 52, 20, 62, 30, 54, 22 },
+        {  3, 35, 11, 43,  1, 33,  9, 41 },
+        { 51, 19, 59, 27, 49, 17, 57, 25 },
+        { 15, 47,  7, 39, 13, 45,  5, 37 },
+        { 63, 31, 55, 23, 61, 29, 53, 21 },
+    };
+    for (int y=0; y < height; y++) {
+        for (int x=0; x < width; x++) {
+            // offset the channels so a grey doesn't step all three at once
+            for (int c=0; c < 3; c++) {
+                error[(y * width + x) * 3 + c] = bayer[(y + c * 3) & 7][(x + c * 5) & 7] * 4;
+            }
+        }
+    }
+}
+
+// Maps npixels RGB pixels from src to dst through the 8.8 fixed point lut,
+// carrying the fraction of every subpixel over to the next frame in error.
+inline void applyDitherLut(const uint16_t lut[3][256], const uint8_t *src, uint8_t *dst,
+                           uint8_t *error, int npixels) {
+    const uint16_t *lr = lut[0], *lg = lut[1], *lb = lut[2];
+    for (int i=0; i < npixels; i++, src += 3, dst += 3, error += 3) {
+        const unsigned r = lr[src[0]] + error[0];
+        const unsigned g = lg[src[1]] + error[1];
+        const unsigned b = lb[src[2]] + error[2];
+        dst[0] = r >> 8; error[0] = r & 0xFF;
+        dst[1] = g >> 8; error[1] = g & 0xFF;
+        dst[2] = b >> 8; error[2] = b & 0xFF;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Fades
+
+#define FADE_ONE 0x10000    // level 1.0 in 16.16 fixed point
+
+// Fade level at time t for a fade in over the first fade_in seconds and a
+// fade out over the last fade_out seconds before end, 0 to FADE_ONE.
+inline uint32_t fadeLevel(double t, double fade_in, double fade_out, double end) {
+    double level = 1.0;
+    if (fade_in > 0 && t < fade_in) {
+        level = t / fade_in;
+    }
+    if (fade_out > 0 && (end - t) / fade_out < level) {
+        level = (end - t) / fade_out;
+    }
+    if (level <= 0) return 0;
+    return (level >= 1.0) ? FADE_ONE : (uint32_t)(level * FADE_ONE + 0.5);
+}
+
+// Scales an 8.8 fixed point table by a fade level into another 8.8 table.
+inline void scaleLut16(const uint16_t base[3][256], uint32_t level, uint16_t lut[3][256]) {
+    for (int c=0; c < 3; c++) {
+        for (int v=0; v < 256; v++) {
+            lut[c][v] = (uint16_t)((base[c][v] * level + 0x8000) >> 16);
+        }
+    }
+}
+
+// Scales an 8.8 fixed point table by a fade level into an 8 bit table.
+inline void scaleLut8(const uint16_t base[3][256], uint32_t level, uint8_t lut[3][256]) {
+    for (int c=0; c < 3; c++) {
+        for (int v=0; v < 256; v++) {
+            lut[c][v] = (uint8_t)(((uint64_t)base[c][v] * level + 0x800000) >> 24);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Panel Remap
+
+struct OutputRemap {
+    int rotate = 0;                 // clockwise, 0, 90, 180 or 270 degrees
+    bool mirror_x = false;          // after rotating
+    bool mirror_y = false;
+    int panel_width = 0;            // chain panels of this size left to right, 0 = off
+    int panel_height = 0;
+    bool serpentine = false;        // every other output row runs right to left
+
+    bool identity() const {
+        return rotate == 0 && !mirror_x && !mirror_y && panel_width == 0 && !serpentine;
+    }
+};
+
+// Size of the image after rotating a width x height canvas.
+inline void remapRotatedSize(const OutputRemap &m, int width, int height, int *rw, int *rh) {
+    const bool swap = (m.rotate == 90 || m.rotate == 270);
+    *rw = swap ? height : width;
+    *rh = swap ? width : height;
+}
+
+// Size of the output for a width x height canvas.
+inline void remapSize(const OutputRemap &m, int width, int height, int *out_w, int *out_h) {
+    remapRotatedSize(m, width, height, out_w, out_h);
+    if (m.panel_width > 0) {
+        const int cols = (*out_w + m.panel_width - 1) / m.panel_width;
+        const int rows = (*out_h + m.panel_height - 1) / m.panel_height;
+        *out_w = cols * rows * m.panel_width;
+        *out_h = m.panel_height;
+    }
+}
+
+// Fills table with the canvas pixel index for every output pixel, -1 where
+// no canvas pixel lands (the unused part of the last panels).
+inline void buildRemapTable(const OutputRemap &m, int width, int height, std::vector<int32_t> &table) {
+    int rw, rh, ow, oh;
+    remapRotatedSize(m, width, height, &rw, &rh);
+    remapSize(m, width, height, &ow, &oh);
+    const int cols = (m.panel_width > 0) ? (rw + m.panel_width - 1) / m.panel_width : 1;
+
+    table.resize(ow * oh);
+    for (int oy=0; oy < oh; oy++) {
+        for (int ox=0; ox < ow; ox++) {
+            // undo the steps in reverse: serpentine, panels, mirror, rotate
+            int x = (m.serpentine && (oy & 1)) ? ow - 1 - ox : ox;
+            int y = oy;
+            if (m.panel_width > 0) {
+                const int panel = x / m.panel_width;
+                x = (panel % cols) * m.panel_width + x % m.panel_width;
+                y = (panel / cols) * m.panel_height + y;
+            }
+            int32_t index = -1;
+            if (x < rw && y < rh) {
+                if (m.mirror_x) x = rw - 1 - x;
+                if (m.mirror_y) y = rh - 1 - y;
+                int cx, cy;
+                switch (m.rotate) {
+                case 90:  cx = y;             cy = height - 1 - x; break;
+                case 180: cx = width - 1 - x; cy = height - 1 - y; break;
+                case 270: cx = width - 1 - y; cy = x;              break;
+                default:  cx = x;             cy = y;              break;
+                }
+                index = cy * width + cx;
+            }
+            table[oy * ow + ox] = index;
+        }
+    }
+}
+
+// Gathers npixels output RGB pixels from src through the remap table.
+inline void applyRemap(const int32_t *table, const uint8_t *src, uint8_t *dst, int npixels) {
+    for (int i=0; i < npixels; i++, dst += 3) {
+        const int32_t j = table[i];
+        if (j >= 0) {
+            memcpy(dst, src + j * 3, 3);
+        }
+        else {
+            dst[0] = dst[1] = dst[2] = 0;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Frame Interpolation
+
+// Blends n bytes of frames a and b into dst, weight 0 (all a) to 256 (all b).
+// A plain loop over bytes in 16 bit arithmetic, which -O3 vectorizes (16 or
+// 32 bytes per instruction with SSE2, AVX2 or NEON).
+inline void lerpFrame(const uint8_t *a, const uint8_t *b, uint8_t *dst, int n, int weight) {
+    const uint16_t wa = (uint16_t)(256 - weight), wb = (uint16_t)weight;
+    for (int i=0; i < n; i++) {
+        dst[i] = (uint8_t)((uint16_t)(a[i] * wa + b[i] * wb + 128) >> 8);
+    }
+}
+
+#endif  // OUTPUT_STAGE_H
@@ -0,0 +1,273 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// palettes
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+// 18/10/2026 - Gradients are interpolated in integers instead of float.
+//
+// Shared 256-color palettes. Gradients and the matplotlib colormaps from
+// fancy-colormaps.h are built at compile time into PaletteTables, so setting
+// a palette is a copy of 256 colors. makeGradientPalette() gives the same
+// colors as the colorGradient() loops the demos used to carry, and can still
+// be called at run time for palettes that depend on options.
+//
+// For animation there is a cosine wave table to index with a moving phase,
+// which replaces calling cos() per palette entry per frame, and PaletteFade,
+// which crossfades from one palette to another with one integer add per
+// channel per frame.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef PALETTES_H
+#define PALETTES_H
+
+#include "udp-flaschen-taschen.h"
+#include "fancy-colormaps.h"
+
+#include <stdint.h>
+#include <math.h>
+#include <initializer_list>
+
+#define PALETTE_WAVE_STEPS 4096     // cosine wave table entries, a power of 2
+
+struct PaletteTable {
+    uint8_t rgb[256][3];
+};
+
+// A linear gradient from color 1 at index start to color 2 at index end.
+struct GradientSegment {
+    int start, end;
+    int r1, g1, b1;
+    int r2, g2, b2;
+};
+
+// Segments are drawn in order, so a later one overwrites an earlier one where
+// they overlap. Entries not covered by any segment are black.
+constexpr PaletteTable makeGradientPalette(std::initializer_list<GradientSegment> segments) {
+    PaletteTable p = {};
+    for (const GradientSegment &s : segments) {
+        // integers only, so a gradient built at run time (matrix) needs no
+        // float divides
+        const int n = (s.end > s.start) ? s.end - s.start : 1;
+        for (int i=0; i <= (s.end - s.start); i++) {
+            p.rgb[s.start + i][0] = (uint8_t)((s.r1 * n + (s.r2 - s.r1) * i) / n);
+            p.rgb[s.start + i][1] = (uint8_t)((s.g1 * n + (s.g2 - s.g1) * i) / n);
+            p.rgb[s.start + i][2] = (uint8_t)((s.b1 * n + (s.b2 - s.b1) * i) / n);
+        }
+    }
+    return p;
+}
+
+// Colormap from fancy-colormaps.h, channels scaled by 256.
+constexpr PaletteTable makeColormapPalette(const RGBFloatCol (&colors)[256]) {
+    PaletteTable p = {};
+    for (int i=0; i < 256; i++) {
+        const float c[3] = { colors[i].r * 256, colors[i].g * 256, colors[i].b * 256 };
+        for (int j=0; j < 3; j++) {
+            p.rgb[i][j] = (c[j] < 255) ? (uint8_t)c[j] : 255;
+        }
+    }
+    return p;
+}
+
+inline void loadPalette(const PaletteTable &table, Color palette[]) {
+    for (int i=0; i < 256; i++) {
+        palette[i].r = table.rgb[i][0];
+        palette[i].g = table.rgb[i][1];
+        palette[i].b = table.rgb[i][2];
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Palettes shared by several demos
+
+// Color wheel: magenta, blue, cyan, green, yellow, orange, red and back to
+// magenta in 8 steps of 32 (life, maze, nb-logo, sierpinski).
+inline constexpr PaletteTable kColorWheelPalette = makeGradientPalette({
+    {   0,  31, 255,   0, 255,   0,   0, 255 },
+    {  32,  63,   0,   0, 255,   0, 255, 255 },
+    {  64,  95,   0, 255, 255,   0, 255,   0 },
+    {  96, 127,   0, 255,   0, 127, 255,   0 },
+    { 128, 159, 127, 255,   0, 255, 255,   0 },
+    { 160, 191, 255, 255,   0, 255, 127,   0 },
+    { 192, 223, 255, 127,   0, 255,   0,   0 },
+    { 224, 255, 255,   0,   0, 255,   0, 255 },
+});
+
+// 1=Nebula 2=Fire 3=Bluegreen in four steps of 64 (hack); index 0 is unused.
+inline constexpr PaletteTable kClassicPalettes[] = {
+    {},
+    makeGradientPalette({   // Nebula
+        {   0,  63,   0,   0,   0,   0,   0, 127 },     // black -> half blue
+        {  64, 127,   0,   0, 127, 127,   0, 255 },     // half blue -> blue-violet
+        { 128, 191, 127,   0, 255, 255,   0,   0 },     // blue-violet -> red
+        { 192, 255, 255,   0,   0, 255, 255, 255 },     // red -> white
+    }),
+    makeGradientPalette({   // Fire
+        {   0,  63,   0,   0,   0,   0,   0, 127 },     // black -> half blue
+        {  64, 127,   0,   0, 127, 255,   0,   0 },     // half blue -> red
+        { 128, 191, 255,   0,   0, 255, 255,   0 },     // red -> yellow
+        { 192, 255, 255, 255,   0, 255, 255, 255 },     // yellow -> white
+    }),
+    makeGradientPalette({   // Bluegreen
+        {   0,  63,   0,   0,   0,   0,   0, 127 },     // black -> half blue
+        {  64, 127,   0,   0, 127,   0, 127, 255 },     // half blue -> teal
+        { 128, 191,   0, 127, 255,   0, 255,   0 },     // teal -> green
+        { 192, 255,   0, 255,   0, 255, 255, 255 },     // green -> white
+    }),
+};
+
+// The plasma palettes: 0=Rainbow 1=Nebula 2=Fire 3=Bluegreen 4=RGB, each
+// running out and back so the plasma wraps without a seam.
+inline constexpr PaletteTable kPlasmaPalettes[] = {
+    makeGradientPalette({   // Rainbow
+        {   0,  35, 255,   0, 255,   0,   0, 255 },     // magenta -> blue
+        {  36,  71,   0,   0, 255,   0, 255, 255 },     // blue -> cyan
+        {  72, 107,   0, 255, 255,   0, 255,   0 },     // cyan -> green
+        { 108, 143,   0, 255,   0, 255, 255,   0 },     // green -> yellow
+        { 144, 179, 255, 255,   0, 255, 127,   0 },     // yellow -> orange
+        { 180, 215, 255, 127,   0, 255,   0,   0 },     // orange -> red
+        { 216, 255, 255,   0,   0, 255,   0, 255 },     // red -> magenta
+    }),
+    makeGradientPalette({   // Nebula
+        {   0,  31,   1,   1,   1,   0,   0, 127 },     // black -> half blue
+        {  32,  95,   0,   0, 127, 127,   0, 255 },     // half blue -> blue-violet
+        {  96, 159, 127,   0, 255, 255,   0,   0 },     // blue-violet -> red
+        { 160, 191, 255,   0,   0, 255, 255, 255 },     // red -> white
+        { 192, 255, 255, 255, 255,   1,   1,   1 },     // white -> black
+    }),
+    makeGradientPalette({   // Fire
+        {   0,  23,   1,   1,   1,   0,   0, 127 },     // black -> half blue
+        {  24,  47,   0,   0, 127, 255,   0,   0 },     // half blue -> red
+        {  48,  95, 255,   0,   0, 255, 255,   0 },     // red -> yellow
+        {  96, 127, 255, 255,   0, 255, 255, 255 },     // yellow -> white
+        { 128, 159, 255, 255, 255, 255, 255,   0 },     // white -> yellow
+        { 160, 207, 255, 255,   0, 255,   0,   0 },     // yellow -> red
+        { 208, 231, 255,   0,   0,   0,   0, 127 },     // red -> half blue
+        { 232, 255,   0,   0, 127,   1,   1,   1 },     // half blue -> black
+    }),
+    makeGradientPalette({   // Bluegreen
+        {   0,  23,   1,   1,   1,   0,   0, 127 },     // black -> half blue
+        {  24,  47,   0,   0, 127,   0, 127, 255 },     // half blue -> teal
+        {  48,  95,   0, 127, 255,   0, 255,   0 },     // teal -> green
+        {  96, 127,   0, 255,   0, 255, 255, 255 },     // green -> white
+        { 128, 159, 255, 255, 255,   0, 255,   0 },     // white -> green
+        { 160, 207,   0, 255,   0,   0, 127, 255 },     // green -> teal
+        { 208, 231,   0, 127, 255,   0,   0, 127 },     // teal -> half blue
+        { 232, 255,   0,   0, 127,   1,   1,   1 },     // half blue -> black
+    }),
+    makeGradientPalette({   // RGB + White
+        {   0,  63,   1,   1,   1, 255,   0,   0 },     // black -> red
+        {  64, 127,   1,   1,   1,   0, 255,   0 },     // black -> green
+        { 128, 191,   1,   1,   1,   0,   0, 255 },     // black -> blue
+        { 192, 255,   1,   1,   1, 255, 255, 255 },     // black -> white
+    }),
+};
+
+inline constexpr PaletteTable kMagmaPalette = makeColormapPalette(kMagmaColors);
+inline constexpr PaletteTable kInfernoPalette = makeColormapPalette(kInfernoColors);
+inline constexpr PaletteTable kPlasmaPalette = makeColormapPalette(kPlasmaColors);
+inline constexpr PaletteTable kViridisPalette = makeColormapPalette(kViridisColors);
+
+// ------------------------------------------------------------------------------------------
+// Cosine wave
+
+// cos(x) for x in [-pi, pi], by its Taylor series; <cmath> isn't constexpr.
+constexpr double paletteCos(double x) {
+    double term = 1, sum = 1;
+    for (int n=1; n < 16; n++) {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+struct PaletteWaveTable {
+    uint8_t level[PALETTE_WAVE_STEPS];
+};
+
+// 128 - 127 * cos(phase) over one turn, as the fractal palette always used.
+constexpr PaletteWaveTable makePaletteWave() {
+    PaletteWaveTable w = {};
+    for (int k=0; k < PALETTE_WAVE_STEPS; k++) {
+        const double turn = (double)k / PALETTE_WAVE_STEPS;
+        const double x = 2 * M_PI * ((turn <= 0.5) ? turn : turn - 1);
+        w.level[k] = (uint8_t)(int)(128.0 - 127.0 * paletteCos(x));
+    }
+    return w;
+}
+
+inline constexpr PaletteWaveTable kPaletteWave = makePaletteWave();
+
+// A phase of the given angle, in 1/PALETTE_WAVE_STEPS of a turn.
+inline uint32_t paletteWavePhase(double radians) {
+    return (uint32_t)(int64_t)llround(radians * (PALETTE_WAVE_STEPS / (2 * M_PI)));
+}
+
+inline uint8_t paletteWave(uint32_t phase) {
+    return kPaletteWave.level[phase & (PALETTE_WAVE_STEPS - 1)];
+}
+
+// ------------------------------------------------------------------------------------------
+// Crossfade
+
+// Fades a palette to a new one over a number of frames. Channels are kept in
+// 16.16 fixed point and stepped by a constant per frame, so each frame costs
+// 768 adds; the last frame lands exactly on the target.
+class PaletteFade {
+public:
+    void Start(const Color from[], const PaletteTable &to, int frames) {
+        target_ = to;
+        left_ = (frames > 0) ? frames : 1;
+        for (int i=0; i < 256; i++) {
+            const uint8_t c[3] = { from[i].r, from[i].g, from[i].b };
+            for (int j=0; j < 3; j++) {
+                value_[i][j] = c[j] << 16;
+                delta_[i][j] = (((int32_t)to.rgb[i][j] << 16) - value_[i][j]) / left_;
+            }
+        }
+    }
+
+    // Writes the next step into palette. Returns false once the fade is done.
+    bool Step(Color palette[]) {
+        if (left_ <= 0) return false;
+        if (--left_ == 0) {
+            loadPalette(target_, palette);
+            return true;
+        }
+        for (int i=0; i < 256; i++) {
+            value_[i][0] += delta_[i][0];
+            value_[i][1] += delta_[i][1];
+            value_[i][2] += delta_[i][2];
+            palette[i].r = value_[i][0] >> 16;
+            palette[i].g = value_[i][1] >> 16;
+            palette[i].b = value_[i][2] >> 16;
+        }
+        return true;
+    }
+
+    bool active() const { return left_ > 0; }
+
+private:
+    PaletteTable target_;
+    int32_t value_[256][3];
+    int32_t delta_[256][3];
+    int left_ = 0;
+};
+
+#endif  // PALETTES_H
@@ -0,0 +1,118 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// pixel-buffer
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Heap-allocated 2D buffer for the demos' working pixels, replacing the
+// stack arrays (uint8_t pixels[width * height]) that overflowed the stack on
+// large -g geometries.
+//
+// The storage is 64-byte aligned and zeroed. By default rows are packed
+// (stride() == width()), as the kernels that walk the buffer as one array
+// expect; with pad_rows every row starts on a 64-byte boundary instead. A
+// buffer converts to T * so it can be passed where the old array was.
+// Resize() keeps the allocation when the new size fits, and the contents when
+// the size is the same, so a buffer can be reused from frame to frame without
+// touching the allocator.
+//
+//  PixelBuffer<uint8_t> pixels(opt_width, opt_height);
+//  blur3(opt_width, opt_height, pixels);
+//  pixels.At(x, y) = 0xFF;
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef PIXEL_BUFFER_H
+#define PIXEL_BUFFER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PIXEL_BUFFER_ALIGN 64
+
+template <class T> class PixelBuffer {
+public:
+    PixelBuffer() {}
+    PixelBuffer(int width, int height, bool pad_rows = false) {
+        Resize(width, height, pad_rows);
+    }
+    ~PixelBuffer() { free(data_); }
+
+    PixelBuffer(const PixelBuffer &) = delete;
+    PixelBuffer &operator=(const PixelBuffer &) = delete;
+
+    // Sets the size and clears the buffer, unless the size is unchanged, in
+    // which case the contents are kept. Only reallocates if it grows.
+    void Resize(int width, int height, bool pad_rows = false) {
+        const size_t per_line = PIXEL_BUFFER_ALIGN / sizeof(T);
+        if (width < 0) width = 0;
+        if (height < 0) height = 0;
+        const size_t stride = (pad_rows && per_line > 0)
+            ? ((size_t)width + per_line - 1) / per_line * per_line
+            : (size_t)width;
+        if (data_ && width == width_ && height == height_ && stride == stride_) {
+            return;
+        }
+        width_ = width;
+        height_ = height;
+        stride_ = stride;
+        const size_t bytes = AlignedBytes(size());
+        if (bytes > capacity_) {
+            free(data_);
+            data_ = (T *)aligned_alloc(PIXEL_BUFFER_ALIGN, bytes);
+            if (!data_) {
+                fprintf(stderr, "Can't allocate a %dx%d pixel buffer\n", width_, height_);
+                abort();
+            }
+            capacity_ = bytes;
+        }
+        Clear();
+    }
+
+    void Clear() { if (data_) memset((void *)data_, 0, size() * sizeof(T)); }
+
+    inline int width() const { return width_; }
+    inline int height() const { return height_; }
+    inline int stride() const { return (int)stride_; }     // in elements
+    inline size_t size() const { return stride_ * height_; }
+
+    inline T *data() { return data_; }
+    inline const T *data() const { return data_; }
+    inline operator T *() { return data_; }
+    inline operator const T *() const { return data_; }
+
+    inline T *Row(int y) { return data_ + (size_t)y * stride_; }
+    inline const T *Row(int y) const { return data_ + (size_t)y * stride_; }
+    inline T &At(int x, int y) { return data_[(size_t)y * stride_ + x]; }
+    inline const T &At(int x, int y) const { return data_[(size_t)y * stride_ + x]; }
+
+private:
+    // aligned_alloc() wants a multiple of the alignment; never 0 bytes
+    static size_t AlignedBytes(size_t count) {
+        const size_t bytes = (count > 0 ? count : 1) * sizeof(T);
+        return (bytes + PIXEL_BUFFER_ALIGN - 1) / PIXEL_BUFFER_ALIGN * PIXEL_BUFFER_ALIGN;
+    }
+
+    T *data_ = NULL;
+    int width_ = 0, height_ = 0;
+    size_t stride_ = 0;
+    size_t capacity_ = 0;
+};
+
+#endif  // PIXEL_BUFFER_H
@@ -0,0 +1,324 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// raster
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Clipped 2-D drawing into a pixel buffer, for index buffers (uint8_t) and
+// color buffers (Color) alike, replacing the drawLine(), drawBox(),
+// drawCircle() and setPixel() copies that blur, hack and lines each carried.
+//
+// A Raster<T> points at the pixels and holds a clip rectangle, by default the
+// whole buffer. Every primitive is clipped against it once, up front, so the
+// inner loops write without bounds checks:
+//
+//  - lines are Bresenham, clipped in step space (Liang-Barsky style): the
+//    first and last step inside the clip are worked out from the line's
+//    error term, so a clipped line sets exactly the pixels the checked loop
+//    did and the loop walks a pointer;
+//  - boxes, filled boxes, filled circles and filled polygons are horizontal
+//    spans, clipped at both ends and filled with std::fill_n (memset for
+//    index buffers);
+//  - circle outlines are the midpoint circle, unchecked when the circle is
+//    inside the clip and checked per point otherwise.
+//
+//  Raster<uint8_t> r(pixels);     // a PixelBuffer, or (T *, width, height)
+//  rasterLine(r, x1, y1, x2, y2, 0xFF);
+//  rasterFillCircle(r, x0, y0, radius, 0x80);
+//
+// Raster also has SetPixel(x, y, color), checked, so it can be passed to
+// drawLine2() and the other Canvas templates in demo-kernels.h.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "pixel-buffer.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <algorithm>
+
+#define RASTER_MAX_CROSSINGS 64     // polygon edges crossing one row
+
+template <class T> struct Raster {
+    Raster(T *pixels, int width, int height, int stride = -1)
+        : pixels(pixels), width(width), height(height),
+          stride((stride < 0) ? width : stride),
+          clip_x0(0), clip_y0(0), clip_x1(width - 1), clip_y1(height - 1) {}
+    Raster(PixelBuffer<T> &buffer)
+        : Raster(buffer.data(), buffer.width(), buffer.height(), buffer.stride()) {}
+
+    // Limits drawing to [x0..x1] x [y0..y1], inclusive, within the buffer.
+    void SetClip(int x0, int y0, int x1, int y1) {
+        clip_x0 = std::max(x0, 0);
+        clip_y0 = std::max(y0, 0);
+        clip_x1 = std::min(x1, width - 1);
+        clip_y1 = std::min(y1, height - 1);
+    }
+
+    bool Inside(int x, int y) const {
+        return (x >= clip_x0) && (x <= clip_x1) && (y >= clip_y0) && (y <= clip_y1);
+    }
+
+    T *Row(int y) const { return pixels + (size_t)y * stride; }
+
+    void SetPixel(int x, int y, const T &color) {
+        if (Inside(x, y)) { Row(y)[x] = color; }
+    }
+
+    T *pixels;
+    int width, height, stride;      // stride in pixels
+    int clip_x0, clip_y0, clip_x1, clip_y1;
+};
+
+// ------------------------------------------------------------------------------------------
+// Spans
+
+// Horizontal run [x1..x2] on row y, either way round.
+template <class T>
+void rasterSpan(Raster<T> &r, int x1, int x2, int y, const T &color) {
+    if (x1 > x2) std::swap(x1, x2);
+    if (y < r.clip_y0 || y > r.clip_y1) return;
+    x1 = std::max(x1, r.clip_x0);
+    x2 = std::min(x2, r.clip_x1);
+    if (x1 > x2) return;
+    std::fill_n(r.Row(y) + x1, x2 - x1 + 1, color);
+}
+
+// Vertical run [y1..y2] in column x, either way round.
+template <class T>
+void rasterColumn(Raster<T> &r, int x, int y1, int y2, const T &color) {
+    if (y1 > y2) std::swap(y1, y2);
+    if (x < r.clip_x0 || x > r.clip_x1) return;
+    y1 = std::max(y1, r.clip_y0);
+    y2 = std::min(y2, r.clip_y1);
+    T *p = r.Row(y1) + x;
+    for (int y=y1; y <= y2; y++, p += r.stride) { *p = color; }
+}
+
+// ------------------------------------------------------------------------------------------
+// Lines
+
+// Floor and ceiling of a / b for b > 0.
+inline int64_t rasterFloorDiv(int64_t a, int64_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+inline int64_t rasterCeilDiv(int64_t a, int64_t b) {
+    return -rasterFloorDiv(-a, b);
+}
+
+// Steps i of a line, start + dir * i, that land in [lo..hi]; narrows [*i0..*i1].
+inline void rasterClipSteps(int start, int dir, int lo, int hi, int64_t *i0, int64_t *i1) {
+    if (dir > 0) {
+        *i0 = std::max(*i0, (int64_t)lo - start);
+        *i1 = std::min(*i1, (int64_t)hi - start);
+    }
+    else {
+        *i0 = std::max(*i0, (int64_t)start - hi);
+        *i1 = std::min(*i1, (int64_t)start - lo);
+    }
+}
+
+// Bresenham's line from (x1, y1) to (x2, y2), both ends included: the same
+// pixels as the classic loop with a bounds check per pixel, but clipped first.
+template <class T>
+void rasterLine(Raster<T> &r, int x1, int y1, int x2, int y2, const T &color) {
+
+    const int deltax = abs(x2 - x1);
+    const int deltay = abs(y2 - y1);
+    const int sx = (x2 >= x1) ? 1 : -1;
+    const int sy = (y2 >= y1) ? 1 : -1;
+
+    // Walk the major axis one pixel a step; the minor axis moves when the
+    // error term num (starting at den / 2, plus numadd a step) passes den,
+    // so after i steps it has moved (den / 2 + i * numadd) / den pixels.
+    const bool x_major = (deltax >= deltay);
+    const int den = x_major ? deltax : deltay;
+    const int numadd = x_major ? deltay : deltax;
+    const int major_start = x_major ? x1 : y1, major_dir = x_major ? sx : sy;
+    const int minor_start = x_major ? y1 : x1, minor_dir = x_major ? sy : sx;
+    const int major_lo = x_major ? r.clip_x0 : r.clip_y0, major_hi = x_major ? r.clip_x1 : r.clip_y1;
+    const int minor_lo = x_major ? r.clip_y0 : r.clip_x0, minor_hi = x_major ? r.clip_y1 : r.clip_x1;
+
+    if (den == 0) {
+        r.SetPixel(x1, y1, color);
+        return;
+    }
+
+    int64_t i0 = 0, i1 = den;
+    rasterClipSteps(major_start, major_dir, major_lo, major_hi, &i0, &i1);
+
+    // The minor offset q(i) = (den / 2 + i * numadd) / den never decreases,
+    // so the steps where q is in [qlo..qhi] are a single run.
+    int64_t qlo, qhi;
+    if (minor_dir > 0) { qlo = (int64_t)minor_lo - minor_start; qhi = (int64_t)minor_hi - minor_start; }
+    else               { qlo = (int64_t)minor_start - minor_hi; qhi = (int64_t)minor_start - minor_lo; }
+    const int64_t half = den / 2;
+    if (numadd == 0) {
+        if (qlo > 0 || qhi < 0) return;
+    }
+    else {
+        i0 = std::max(i0, rasterCeilDiv(qlo * den - half, numadd));
+        i1 = std::min(i1, rasterFloorDiv((qhi + 1) * den - half - 1, numadd));
+    }
+    if (i0 > i1) return;
+
+    // start at step i0, then no more checks
+    const int64_t err = half + i0 * numadd;
+    const int q = (int)(err / den);
+    int num = (int)(err % den);
+    const int x = x_major ? x1 + sx * (int)i0 : x1 + sx * q;
+    const int y = x_major ? y1 + sy * q : y1 + sy * (int)i0;
+    const ptrdiff_t major_step = x_major ? sx : (ptrdiff_t)sy * r.stride;
+    const ptrdiff_t minor_step = x_major ? (ptrdiff_t)sy * r.stride : sx;
+    T *p = r.Row(y) + x;
+    for (int64_t i=i0; i <= i1; i++) {
+        *p = color;
+        num += numadd;
+        if (num >= den) {
+            num -= den;
+            p += minor_step;
+        }
+        p += major_step;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Boxes
+
+// Outline of the box with corners (x1, y1) and (x2, y2), inclusive.
+template <class T>
+void rasterBox(Raster<T> &r, int x1, int y1, int x2, int y2, const T &color) {
+    rasterSpan(r, x1, x2, y1, color);
+    rasterSpan(r, x1, x2, y2, color);
+    rasterColumn(r, x1, y1, y2, color);
+    rasterColumn(r, x2, y1, y2, color);
+}
+
+template <class T>
+void rasterFillBox(Raster<T> &r, int x1, int y1, int x2, int y2, const T &color) {
+    if (y1 > y2) std::swap(y1, y2);
+    y1 = std::max(y1, r.clip_y0);
+    y2 = std::min(y2, r.clip_y1);
+    for (int y=y1; y <= y2; y++) { rasterSpan(r, x1, x2, y, color); }
+}
+
+// ------------------------------------------------------------------------------------------
+// Circles
+
+// Midpoint circle outline, based off code from ft/api/lib/graphics.cc.
+template <class T>
+void rasterCircle(Raster<T> &r, int x0, int y0, int radius, const T &color) {
+
+    const bool inside = (x0 - radius >= r.clip_x0) && (x0 + radius <= r.clip_x1)
+                     && (y0 - radius >= r.clip_y0) && (y0 + radius <= r.clip_y1);
+    const bool outside = (x0 + radius < r.clip_x0) || (x0 - radius > r.clip_x1)
+                      || (y0 + radius < r.clip_y0) || (y0 - radius > r.clip_y1);
+    if (outside || radius < 0) return;
+
+    int x = radius, y = 0;
+    int radiusError = 1 - x;
+    while (y <= x) {
+        const int px[8] = { x, y, -x, -y, -x, -y,  x,  y };
+        const int py[8] = { y, x,  y,  x, -y, -x, -y, -x };
+        for (int k=0; k < 8; k++) {
+            if (inside) { r.Row(y0 + py[k])[x0 + px[k]] = color; }
+            else        { r.SetPixel(x0 + px[k], y0 + py[k], color); }
+        }
+        y++;
+        if (radiusError < 0) {
+            radiusError += 2 * y + 1;
+        }
+        else {
+            x--;
+            radiusError += 2 * (y - x + 1);
+        }
+    }
+}
+
+// The same circle, filled with spans.
+template <class T>
+void rasterFillCircle(Raster<T> &r, int x0, int y0, int radius, const T &color) {
+    if (radius < 0) return;
+    int x = radius, y = 0;
+    int radiusError = 1 - x;
+    while (y <= x) {
+        rasterSpan(r, x0 - x, x0 + x, y0 + y, color);
+        rasterSpan(r, x0 - x, x0 + x, y0 - y, color);
+        rasterSpan(r, x0 - y, x0 + y, y0 + x, color);
+        rasterSpan(r, x0 - y, x0 + y, y0 - x, color);
+        y++;
+        if (radiusError < 0) {
+            radiusError += 2 * y + 1;
+        }
+        else {
+            x--;
+            radiusError += 2 * (y - x + 1);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Polygons
+
+struct RasterPoint {
+    int x, y;
+};
+
+// Fills the polygon through the n points (closed back to the first), even-odd
+// rule. A pixel is filled when its center is inside, so polygons that share an
+// edge don't overlap.
+template <class T>
+void rasterFillPolygon(Raster<T> &r, const RasterPoint points[], int n, const T &color) {
+
+    if (n < 3) return;
+    int top = points[0].y, bottom = points[0].y;
+    for (int i=1; i < n; i++) {
+        top = std::min(top, points[i].y);
+        bottom = std::max(bottom, points[i].y);
+    }
+    top = std::max(top, r.clip_y0);
+    bottom = std::min(bottom, r.clip_y1);
+
+    int crossings[RASTER_MAX_CROSSINGS];
+    for (int y=top; y <= bottom; y++) {
+        // where each edge crosses the row's center line y + 1/2, in half
+        // pixels, rounded up
+        int count = 0;
+        for (int i=0; i < n && count < RASTER_MAX_CROSSINGS; i++) {
+            const RasterPoint &a = points[i], &b = points[(i + 1) % n];
+            if ((a.y <= y) == (b.y <= y)) continue;
+            const int64_t num = (int64_t)(2 * y + 1 - 2 * a.y) * (b.x - a.x);
+            crossings[count++] = 2 * a.x + (int)rasterCeilDiv((b.y > a.y) ? num : -num,
+                                                               abs(b.y - a.y));
+        }
+        std::sort(crossings, crossings + count);
+        // pixel x is in when its center 2x + 1 is at or after one crossing and
+        // before the next
+        for (int i=0; i + 1 < count; i += 2) {
+            const int x1 = (int)rasterFloorDiv(crossings[i], 2);
+            const int x2 = (int)rasterFloorDiv(crossings[i + 1] - 2, 2);
+            if (x1 <= x2) rasterSpan(r, x1, x2, y, color);
+        }
+    }
+}
+
+#endif  // RASTER_H
@@ -0,0 +1,226 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// realtime
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Real-time scheduling for the render hosts, where other processes waking up
+// make frames late and the panels show the hitch.
+//
+// A policy is given as "fifo" or "rr" (SCHED_FIFO, SCHED_RR) with an optional
+// priority, e.g. "fifo:60", or "off". realtimeSetThread() applies it and a CPU
+// list ("2", "2,3", "1-3") to a thread. realtimeLockMemory() locks the process
+// in memory with mlockall(), which also faults in everything mapped now and
+// later, keeps freed heap memory from going back to the system and faults in
+// some stack, so a frame never waits on a page fault.
+//
+// Without the rights to do so (CAP_SYS_NICE, or rtprio and memlock limits in
+// /etc/security/limits.conf) a warning is printed and the program goes on
+// with normal scheduling.
+//
+// JitterReport collects how late the program woke up against its deadlines:
+//
+//  jitter: 1500 frames, late mean 0.041 ms, max 1.874 ms, 3 over 1 ms
+//    < 0.05  ms      1288
+//    < 0.1   ms       160
+//    ...
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#define REALTIME_PRIORITY 50            // default priority for fifo and rr
+#define REALTIME_STACK_PREFAULT (256 * 1024)    // bytes of stack faulted in
+#define JITTER_MISS_MSEC 1.0            // later than this counts as a miss
+#define JITTER_BUCKETS 10
+
+// Parses "fifo[:prio]", "rr[:prio]" or "off". Returns false if invalid.
+inline bool realtimeParsePolicy(const char *arg, int *policy, int *priority) {
+    char name[8];
+    int prio = REALTIME_PRIORITY, n = 0, m = 0;
+    if (sscanf(arg, "%7[a-z]%n", name, &n) != 1) return false;
+    if (arg[n] == ':') {
+        if (sscanf(arg + n + 1, "%d%n", &prio, &m) != 1 || arg[n + 1 + m] != '\0') return false;
+    }
+    else if (arg[n] != '\0') {
+        return false;
+    }
+    const int min = sched_get_priority_min(SCHED_FIFO), max = sched_get_priority_max(SCHED_FIFO);
+    if (prio < min || prio > max) return false;
+    if (strcmp(name, "fifo") == 0) { *policy = SCHED_FIFO; }
+    else if (strcmp(name, "rr") == 0) { *policy = SCHED_RR; }
+    else if (strcmp(name, "off") == 0) { *policy = SCHED_OTHER; prio = 0; }
+    else return false;
+    *priority = prio;
+    return true;
+}
+
+// Parses a CPU list like "3", "0,2" or "1-3,6". Returns false if invalid.
+inline bool realtimeParseCpus(const char *arg, std::vector<int> *cpus) {
+    std::vector<int> list;
+    const char *p = arg;
+    for (;;) {
+        int a, b, n = 0;
+        if (sscanf(p, "%d%n", &a, &n) != 1 || a < 0 || a >= CPU_SETSIZE) return false;
+        p += n;
+        b = a;
+        if (*p == '-') {
+            if (sscanf(p + 1, "%d%n", &b, &n) != 1 || b < a || b >= CPU_SETSIZE) return false;
+            p += n + 1;
+        }
+        for (int c=a; c <= b; c++) { list.push_back(c); }
+        if (*p == '\0') break;
+        if (*p++ != ',') return false;
+    }
+    *cpus = list;
+    return true;
+}
+
+// Sets the scheduling of a thread and pins it to cpus (if not empty).
+// Prints a warning and returns false on failure.
+inline bool realtimeSetThread(pthread_t thread, int policy, int priority, const std::vector<int> &cpus) {
+    bool ok = true;
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : cpus) { CPU_SET(c, &set); }
+        const int e = pthread_setaffinity_np(thread, sizeof(set), &set);
+        if (e != 0) {
+            fprintf(stderr, "realtime: CPU affinity: %s\n", strerror(e));
+            ok = false;
+        }
+    }
+    if (policy != SCHED_OTHER) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        const int e = pthread_setschedparam(thread, policy, &param);
+        if (e != 0) {
+            fprintf(stderr, "realtime: scheduling: %s; running with normal scheduling\n", strerror(e));
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Faults in stack below the caller.
+inline void __attribute__((noinline)) realtimePrefaultStack() {
+    uint8_t stack[REALTIME_STACK_PREFAULT];
+    memset(stack, 0, sizeof(stack));
+    __asm__ __volatile__("" : : "r"(stack) : "memory");
+}
+
+// Locks all memory of the process, now and later, and faults it in. Prints
+// a warning and returns false on failure.
+inline bool realtimeLockMemory() {
+    // freed memory stays in the heap instead of being unmapped, and large
+    // blocks come from the heap rather than from their own mappings
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        fprintf(stderr, "realtime: mlockall: %s\n", strerror(errno));
+        return false;
+    }
+    realtimePrefaultStack();
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------
+// Jitter
+
+// Distribution of how late a thread woke up. Add() is called by one thread,
+// the others may read it any time.
+class JitterReport {
+public:
+    // Upper bounds of the buckets, msec; the last is open.
+    static const double *Limits() {
+        static const double limits[JITTER_BUCKETS - 1] = {
+            0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10, 20
+        };
+        return limits;
+    }
+
+    // late: seconds past the deadline, negative if early.
+    void Add(double late) {
+        const double ms = (late > 0) ? late * 1000 : 0;
+        int b = 0;
+        while (b < JITTER_BUCKETS - 1 && ms >= Limits()[b]) { b++; }
+        buckets_[b].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_us_.fetch_add((long)(ms * 1000), std::memory_order_relaxed);
+        if ((long)(ms * 1000) > max_us_.load(std::memory_order_relaxed)) {
+            max_us_.store((long)(ms * 1000), std::memory_order_relaxed);
+        }
+        if (ms > JITTER_MISS_MSEC) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    long count() const { return count_.load(std::memory_order_relaxed); }
+    long misses() const { return misses_.load(std::memory_order_relaxed); }
+    double max() const { return max_us_.load(std::memory_order_relaxed) / 1000.0; }   // msec
+    double mean() const {                                                             // msec
+        const long n = count();
+        return (n > 0) ? sum_us_.load(std::memory_order_relaxed) / 1000.0 / n : 0;
+    }
+
+    // One line, for the control channel's stats.
+    std::string Summary() const {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "late_mean %.3f late_max %.3f misses %ld",
+                 mean(), max(), misses());
+        return buf;
+    }
+
+    void Print(FILE *out, const char *what) const {
+        fprintf(out, "jitter: %ld %s, late mean %.3f ms, max %.3f ms, %ld over %g ms\n",
+                count(), what, mean(), max(), misses(), JITTER_MISS_MSEC);
+        for (int b=0; b < JITTER_BUCKETS; b++) {
+            const long n = buckets_[b].load(std::memory_order_relaxed);
+            if (b < JITTER_BUCKETS - 1) {
+                fprintf(out, "  < %-5g ms  %8ld\n", Limits()[b], n);
+            }
+            else {
+                fprintf(out, " >= %-5g ms  %8ld\n", Limits()[b - 1], n);
+            }
+        }
+    }
+
+private:
+    std::atomic<long> buckets_[JITTER_BUCKETS] = {};
+    std::atomic<long> count_{0};
+    std::atomic<long> misses_{0};
+    std::atomic<long> sum_us_{0};
+    std::atomic<long> max_us_{0};
+};
+
+#endif  // REALTIME_H
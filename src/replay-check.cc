@@ -0,0 +1,197 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// replay-check
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// Compares two per-frame hash streams written by a demo with --hash and
+// reports the first frame where they diverge. If both runs also dumped their
+// frames with --dump-frames, the divergent frame is compared pixel by pixel.
+//
+// Exits with status 0 if the runs match, 2 if they diverge.
+//
+// How to run:
+//
+//  ./blur --seed 1 --fixed-clock -t 30 --hash ref.hash
+//  ./blur --seed 1 --fixed-clock -t 30 --hash new.hash
+//  ./replay-check ref.hash new.hash
+//
+// To see command line options:
+//  ./replay-check -?
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// ------------------------------------------------------------------------------------------
+// Command Line Options
+
+// option vars
+const char *opt_frames_a = NULL;
+const char *opt_frames_b = NULL;
+
+int usage(const char *progname) {
+
+    fprintf(stderr, "Replay check (c) 2026 James Crowley (judgejc.net)\n");
+    fprintf(stderr, "Usage: %s [options] <a.hash> <b.hash>\n", progname);
+    fprintf(stderr, "Options:\n"
+        "\t-a <dir>       : Frames of run a (--dump-frames) for a pixel diff.\n"
+        "\t-b <dir>       : Frames of run b (--dump-frames) for a pixel diff.\n"
+    );
+    return 1;
+}
+
+int cmdLine(int argc, char *argv[]) {
+
+    // command line options
+    int opt;
+    while ((opt = getopt(argc, argv, "?a:b:")) != -1) {
+        switch (opt) {
+        case '?':  // help
+            return usage(argv[0]);
+            break;
+        case 'a':
+            opt_frames_a = optarg;
+            break;
+        case 'b':
+            opt_frames_b = optarg;
+            break;
+        default:
+            return usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2) {
+        return usage(argv[0]);
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------
+
+struct FrameHash {
+    long frame;
+    unsigned long long hash;
+};
+
+bool readHashes(const char *filename, std::vector<FrameHash> &hashes) {
+    FILE *f = fopen(filename, "r");
+    if (!f) {
+        perror(filename);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        FrameHash h;
+        if (sscanf(line, "%ld %llx", &h.frame, &h.hash) == 2) {
+            hashes.push_back(h);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// Reads a binary PPM as written by --dump-frames.
+bool readFrame(const char *dir, long frame, int *width, int *height, std::vector<uint8_t> &pixels) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/frame-%06ld.ppm", dir, frame);
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    bool ok = (fscanf(f, "P6 %d %d 255", width, height) == 2) && (fgetc(f) == '\n');
+    if (ok) {
+        pixels.resize(*width * *height * 3);
+        ok = (fread(pixels.data(), 3, *width * *height, f) == (size_t)(*width * *height));
+    }
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "%s: not a frame dump\n", path);
+    }
+    return ok;
+}
+
+void diffFrames(long frame) {
+    int wa, ha, wb, hb;
+    std::vector<uint8_t> a, b;
+    if (!readFrame(opt_frames_a, frame, &wa, &ha, a) || !readFrame(opt_frames_b, frame, &wb, &hb, b)) {
+        return;
+    }
+    if (wa != wb || ha != hb) {
+        printf("  size differs: %dx%d vs %dx%d\n", wa, ha, wb, hb);
+        return;
+    }
+    int count = 0, x0 = wa, y0 = ha, x1 = -1, y1 = -1;
+    for (int y=0; y < ha; y++) {
+        for (int x=0; x < wa; x++) {
+            const int i = (y * wa + x) * 3;
+            if (memcmp(&a[i], &b[i], 3) != 0) {
+                if (count == 0) {
+                    printf("  first pixel (%d,%d): %02x%02x%02x vs %02x%02x%02x\n",
+                           x, y, a[i], a[i+1], a[i+2], b[i], b[i+1], b[i+2]);
+                }
+                count++;
+                if (x < x0) x0 = x;
+                if (y < y0) y0 = y;
+                if (x > x1) x1 = x;
+                if (y > y1) y1 = y;
+            }
+        }
+    }
+    if (count == 0) {
+        printf("  pixels identical (offset or layer differs)\n");
+    }
+    else {
+        printf("  %d pixels differ within (%d,%d)-(%d,%d)\n", count, x0, y0, x1, y1);
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    // parse command line
+    if (int e = cmdLine(argc, argv)) { return e; }
+
+    std::vector<FrameHash> a, b;
+    if (!readHashes(argv[optind], a) || !readHashes(argv[optind + 1], b)) {
+        return 1;
+    }
+
+    const size_t n = (a.size() < b.size()) ? a.size() : b.size();
+    for (size_t i=0; i < n; i++) {
+        if (a[i].hash != b[i].hash) {
+            printf("Diverged at frame %ld: %016llx vs %016llx\n", a[i].frame, a[i].hash, b[i].hash);
+            if (opt_frames_a && opt_frames_b) {
+                diffFrames(a[i].frame);
+            }
+            return 2;
+        }
+    }
+    if (a.size() != b.size()) {
+        printf("Identical for %zu frames, then %s ends (%zu vs %zu frames)\n",
+               n, (a.size() < b.size()) ? "a" : "b", a.size(), b.size());
+        return 2;
+    }
+    printf("Identical: %zu frames\n", n);
+    return 0;
+}
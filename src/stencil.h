@@ -0,0 +1,278 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// stencil
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// A 3x3 stencil engine for the simulation-style kernels (blur, life, matrix
+// rain, cellular automata): each cell of the next frame is a function of the
+// cell and its eight neighbours in the current one.
+//
+// The kernel is a functor taking a StencilCells<T> (the 3x3 neighbourhood, by
+// compass point) and returning the new cell. The engine does the indexing and
+// the borders, where the neighbours outside the frame are:
+//
+//  STENCIL_ZERO    zero
+//  STENCIL_CLAMP   the nearest cell on the edge
+//  STENCIL_WRAP    from the opposite edge (a torus)
+//
+// It always reads one frame and writes another, so a kernel can't see cells
+// it has already updated. stencilStep() works between two buffers (ping-pong);
+// stencilInPlace() keeps copies of the rows it still needs as it goes, or
+// none for kernels that only look right and down (see StencilForward).
+//
+//  struct Blur { uint8_t operator()(const StencilCells<uint8_t> &n) const {
+//      return (n.c + n.e + n.s + n.se) >> 2; } };
+//  stencilInPlace(pixels, width, height, STENCIL_ZERO, Blur());
+//
+// The frame is worked in bands of STENCIL_BAND rows, so the three rows being
+// read stay in cache, and big frames run the bands over the thread pool
+// (thread-pool.h); the result doesn't depend on the number of threads. Inside
+// a row the border columns are done apart, leaving a plain loop over the
+// inner cells that the compiler vectorizes for uint8_t, int16_t and float
+// cells once the kernel is inlined.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include "pixel-buffer.h"
+#include "thread-pool.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+#define STENCIL_BAND 16                 // rows per band
+#define STENCIL_PARALLEL_MIN (1 << 16)  // cells in a frame before using threads
+
+enum StencilBorder {
+    STENCIL_ZERO,
+    STENCIL_CLAMP,
+    STENCIL_WRAP,
+};
+
+// A cell and its neighbours: nw n ne / w c e / sw s se.
+template <class T> struct StencilCells {
+    T nw, n, ne;
+    T w, c, e;
+    T sw, s, se;
+};
+
+// Row y of a frame h rows high, or -1 for outside (zero border).
+inline int stencilResolve(int y, int h, StencilBorder border) {
+    if (y >= 0 && y < h) return y;
+    switch (border) {
+    case STENCIL_ZERO:  return -1;
+    case STENCIL_CLAMP: return (y < 0) ? 0 : h - 1;
+    case STENCIL_WRAP:  return (y < 0) ? y + h : y - h;
+    }
+    return -1;
+}
+
+// Cell x of a row from the rows above, at and below it, where l and r are
+// the columns to its left and right, -1 for zero.
+template <class T, class Kernel>
+inline T stencilEdge(const T *up, const T *mid, const T *down, int x, int l, int r,
+                     const Kernel &kernel) {
+    const StencilCells<T> n = {
+        (l < 0) ? T() : up[l],   up[x],   (r < 0) ? T() : up[r],
+        (l < 0) ? T() : mid[l],  mid[x],  (r < 0) ? T() : mid[r],
+        (l < 0) ? T() : down[l], down[x], (r < 0) ? T() : down[r],
+    };
+    return kernel(n);
+}
+
+// One row of the next frame from the rows above, at and below it. xl and xr
+// are the columns left of the first and right of the last, -1 for zero. The
+// cells are written left to right, each after its own neighbours are read.
+template <class T, class Kernel>
+inline void stencilRow(const T *up, const T *mid, const T *down, T *out, int width,
+                       int xl, int xr, const Kernel &kernel) {
+
+    if (width == 1) {
+        out[0] = stencilEdge(up, mid, down, 0, xl, xr, kernel);
+        return;
+    }
+    out[0] = stencilEdge(up, mid, down, 0, xl, 1, kernel);
+
+    // inner cells, no border to think about
+    for (int x=1; x < width - 1; x++) {
+        const StencilCells<T> n = {
+            up[x - 1],   up[x],   up[x + 1],
+            mid[x - 1],  mid[x],  mid[x + 1],
+            down[x - 1], down[x], down[x + 1],
+        };
+        out[x] = kernel(n);
+    }
+
+    out[width - 1] = stencilEdge(up, mid, down, width - 1, width - 2, xr, kernel);
+}
+
+// Kernels that read only c, e, s and se can declare
+//  static constexpr bool kForward = true;
+// and are then updated in place without copying anything.
+template <class Kernel, class = void> struct StencilForward { static constexpr bool value = false; };
+template <class Kernel> struct StencilForward<Kernel, std::void_t<decltype(Kernel::kForward)>> {
+    static constexpr bool value = Kernel::kForward;
+};
+
+// A row of a forward kernel, in place. Going through the one pointer lets the
+// compiler see that each cell is read before it's written, and vectorize.
+template <class T, class Kernel>
+inline void stencilForwardRow(T *row, const T *down, int width, int xr,
+                              const Kernel &kernel) {
+    const Kernel k = kernel;    // a copy can't alias the row
+    for (int x=0; x < width - 1; x++) {
+        const StencilCells<T> n = {
+            T(), T(),        T(),
+            T(), row[x],     row[x + 1],
+            T(), down[x],    down[x + 1],
+        };
+        row[x] = k(n);
+    }
+    const StencilCells<T> n = {
+        T(), T(),                T(),
+        T(), row[width - 1],     (xr < 0) ? T() : row[xr],
+        T(), down[width - 1],    (xr < 0) ? T() : down[xr],
+    };
+    row[width - 1] = k(n);
+}
+
+// A row of zeros at least width long, for the zero border.
+template <class T>
+inline const T *stencilZeros(int width) {
+    static thread_local PixelBuffer<T> zeros;
+    if (zeros.width() < width) { zeros.Resize(width, 1); }     // cleared, never written
+    return zeros.data();
+}
+
+// One step from src to dst, which must not overlap.
+template <class T, class Kernel>
+inline void stencilStep(const T *src, T *dst, int width, int height, StencilBorder border,
+                 const Kernel &kernel) {
+
+    if (width < 1 || height < 1) return;
+    const T *zeros = stencilZeros<T>(width);
+    const int xl = stencilResolve(-1, width, border);
+    const int xr = stencilResolve(width, width, border);
+
+    const int bands = (height + STENCIL_BAND - 1) / STENCIL_BAND;
+    auto band = [&](int i) {
+        const int y1 = (i * STENCIL_BAND + STENCIL_BAND < height) ? i * STENCIL_BAND + STENCIL_BAND : height;
+        for (int y=i * STENCIL_BAND; y < y1; y++) {
+            const int yu = stencilResolve(y - 1, height, border);
+            const int yd = stencilResolve(y + 1, height, border);
+            stencilRow((yu < 0) ? zeros : src + (size_t)yu * width, src + (size_t)y * width,
+                       (yd < 0) ? zeros : src + (size_t)yd * width, dst + (size_t)y * width,
+                       width, xl, xr, kernel);
+        }
+    };
+    if ((long)width * height >= STENCIL_PARALLEL_MIN && bands > 1) {
+        demoThreadPool().Run(bands, band);
+    }
+    else {
+        for (int i=0; i < bands; i++) { band(i); }
+    }
+}
+
+// One step of the frame in pixels. Big frames are copied to a scratch buffer
+// and stepped in bands over the thread pool; small ones go a row at a time,
+// keeping copies of only the rows that are still to be read once overwritten:
+// the one above and, for the wrap border, the first.
+template <class T, class Kernel>
+inline void stencilInPlace(T pixels[], int width, int height, StencilBorder border,
+                    const Kernel &kernel) {
+
+    if (width < 1 || height < 1) return;
+    if constexpr (StencilForward<Kernel>::value) {
+        if (border != STENCIL_WRAP) {
+            // the cells to the right and below aren't written yet
+            const T *zeros = stencilZeros<T>(width);
+            const int xr = stencilResolve(width, width, border);
+            for (int y=0; y < height - 1; y++) {
+                stencilForwardRow(pixels + (size_t)y * width, pixels + (size_t)(y + 1) * width,
+                                  width, xr, kernel);
+            }
+            T *last = pixels + (size_t)(height - 1) * width;
+            stencilForwardRow(last, (border == STENCIL_ZERO) ? zeros : last, width, xr, kernel);
+            return;
+        }
+    }
+    if ((long)width * height >= STENCIL_PARALLEL_MIN) {
+        static thread_local PixelBuffer<T> scratch;
+        scratch.Resize(width, height);
+        memcpy((void *)scratch.data(), pixels, (size_t)width * height * sizeof(T));
+        stencilStep(scratch.data(), pixels, width, height, border, kernel);
+        return;
+    }
+
+    static thread_local PixelBuffer<T> saved;
+    saved.Resize(width, 3);
+    T *first = saved.Row(0), *prev = saved.Row(1), *cur = saved.Row(2);
+    const T *zeros = stencilZeros<T>(width);
+    const int xl = stencilResolve(-1, width, border);
+    const int xr = stencilResolve(width, width, border);
+    const size_t bytes = (size_t)width * sizeof(T);
+    memcpy((void *)first, pixels, bytes);
+
+    for (int y=0; y < height; y++) {
+        T *row = pixels + (size_t)y * width;
+        if (y > 0) { memcpy((void *)cur, row, bytes); }
+        const T *mid = (y > 0) ? cur : first;
+        const T *up = (y > 0) ? prev
+                    : (border == STENCIL_ZERO) ? zeros
+                    : (border == STENCIL_CLAMP || height == 1) ? first
+                    : pixels + (size_t)(height - 1) * width;
+        const T *down = (y + 1 < height) ? row + width
+                      : (border == STENCIL_ZERO) ? zeros
+                      : (border == STENCIL_CLAMP) ? mid
+                      : first;
+        stencilRow(up, mid, down, row, width, xl, xr, kernel);
+        if (y > 0) { std::swap(prev, cur); }
+        else { memcpy((void *)prev, first, bytes); }
+    }
+}
+
+// Two frames that take turns being read and written, for demos that keep
+// their state in the stencil's own buffers.
+template <class T> class StencilBuffers {
+public:
+    StencilBuffers(int width, int height) {
+        frames_[0].Resize(width, height);
+        frames_[1].Resize(width, height);
+    }
+
+    // The current frame.
+    PixelBuffer<T> &front() { return frames_[front_]; }
+
+    template <class Kernel>
+    void Step(StencilBorder border, const Kernel &kernel) {
+        PixelBuffer<T> &src = frames_[front_], &dst = frames_[front_ ^ 1];
+        stencilStep(src.data(), dst.data(), src.width(), src.height(), border, kernel);
+        front_ ^= 1;
+    }
+
+private:
+    PixelBuffer<T> frames_[2];
+    int front_ = 0;
+};
+
+#endif  // STENCIL_H
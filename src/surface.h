@@ -0,0 +1,138 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// surface
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+//
+// The render surface behind DemoCanvas: a frame of 32 bit RGBX pixels (red,
+// green, blue and a byte of padding) instead of the packed 3 byte Colors of
+// the transmit buffer. Every pixel is an aligned 32 bit load or store, and
+// the byte loops over a row of them (effects.h, fades, blends) work on four
+// channels at a time without a pixel straddling two vector lanes.
+//
+// Drawing goes into the surface, through DemoCanvas::SetPixel() or directly
+// (Raster<Rgbx>, the blits below, EffectStack::Apply()), and packRgb24()
+// turns it into the RGB bytes of the PPM payload once, when the frame is sent:
+//
+//  Surface &surface = canvas.surface();
+//  blitPalette(pixels, palette32, surface.data(), width * height);
+//  canvas.Send();
+//
+// The pack is 16 pixels an instruction with NEON (any aarch64 build), 4 with
+// SSSE3 (CXXFLAGS+=-mssse3), and 2 a 64 bit word otherwise.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include "udp-flaschen-taschen.h"
+#include "pixel-buffer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// A pixel of the surface; x is padding and always 0.
+struct alignas(4) Rgbx {
+    uint8_t r, g, b, x;
+
+    Rgbx() = default;   // uninitialized, like Color's members
+    constexpr Rgbx(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b), x(0) {}
+    constexpr Rgbx(const Color &c) : r(c.r), g(c.g), b(c.b), x(0) {}
+
+    Color color() const { return Color(r, g, b); }
+    bool operator==(const Rgbx &o) const { return r == o.r && g == o.g && b == o.b; }
+    bool operator!=(const Rgbx &o) const { return !(*this == o); }
+};
+
+static_assert(sizeof(Rgbx) == 4, "Rgbx is one 32 bit word");
+
+typedef PixelBuffer<Rgbx> Surface;
+
+// ------------------------------------------------------------------------------------------
+// Pack
+
+// The RGB bytes of n pixels into dst (3 * n bytes, any alignment).
+inline void packRgb24(const Rgbx src[], uint8_t dst[], size_t n) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16x4_t p = vld4q_u8((const uint8_t *)(src + i));
+        uint8x16x3_t rgb;
+        rgb.val[0] = p.val[0];
+        rgb.val[1] = p.val[1];
+        rgb.val[2] = p.val[2];
+        vst3q_u8(dst + 3 * i, rgb);
+    }
+#elif defined(__SSSE3__)
+    // 4 pixels to 12 bytes a shuffle; each 16 byte store runs 4 bytes into
+    // the next group, which is written after it, so stop 2 groups short
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; i + 8 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + 3 * i), _mm_shuffle_epi8(p, shuffle));
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // 2 pixels to 6 bytes of a 64 bit store; the other 2 are written again
+    // by the next store, so the last one must still be inside dst
+    for (; i + 3 <= n; i += 2) {
+        uint64_t p;
+        memcpy(&p, src + i, sizeof(p));
+        p = (p & 0xFFFFFF) | ((p >> 8) & 0xFFFFFF000000ULL);
+        memcpy(dst + 3 * i, &p, sizeof(p));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[3 * i] = src[i].r;
+        dst[3 * i + 1] = src[i].g;
+        dst[3 * i + 2] = src[i].b;
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Blits
+
+// The surface's own copy of a palette.
+inline void paletteRgbx(const Color palette[], Rgbx out[], int n = 256) {
+    for (int i=0; i < n; i++) { out[i] = Rgbx(palette[i]); }
+}
+
+// dst[i] = palette[pixels[i]] for n pixels.
+inline void blitPalette(const uint8_t pixels[], const Rgbx palette[], Rgbx dst[], size_t n) {
+    for (size_t i=0; i < n; i++) { dst[i] = palette[pixels[i]]; }
+}
+
+// dst[i] = src[i] for n pixels.
+inline void blitColors(const Color src[], Rgbx dst[], size_t n) {
+    for (size_t i=0; i < n; i++) { dst[i] = Rgbx(src[i]); }
+}
+
+inline void fillSurface(Surface &surface, const Rgbx &color) {
+    Rgbx *p = surface.data();
+    for (size_t i=0; i < surface.size(); i++) { p[i] = color; }
+}
+
+#endif  // SURFACE_H
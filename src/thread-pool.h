@@ -0,0 +1,267 @@
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; -*-
+//
+// thread-pool
+// Copyright (c) 2026 James Crowley (judgejc.net)
+// https://github.com/judgejc/ft-demos
+//
+// 18/10/2026 - Initial version.
+// 18/10/2026 - Added ForEachWorker() for the real-time settings (realtime.h).
+//
+// A small thread pool for splitting per-frame render work into tiles.
+//
+// The calling thread takes part in the work, so a pool of N threads starts
+// N-1 workers, each pinned to one of the CPUs the process may run on. Every
+// thread starts on its own share of the tiles and steals from the others when
+// it runs out. Between jobs the workers spin for a short while before going to
+// sleep on a futex, so back-to-back jobs of a few microseconds each don't pay
+// for a wake-up. With more threads than CPUs they sleep straight away, as a
+// spinning thread would only hold up the ones doing the work.
+//
+// The number of threads comes from --threads, the FT_THREADS environment
+// variable, or the number of CPUs, in that order. With one thread everything
+// runs inline on the caller.
+//
+//  parallelForTiles(width, height, 16, [&](const Tile &t) {
+//      for (int y=t.y0; y < t.y1; y++)
+//          for (int x=t.x0; x < t.x1; x++)
+//              ...
+//  });
+//
+// Tiles must not depend on each other; the result is then the same as the
+// serial loop whatever the number of threads.
+//
+// --------------------------------------------------------------------------------
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://gnu.org/licenses/gpl-2.0.txt>
+//
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define THREAD_POOL_MAX 64
+#define THREAD_POOL_SPIN 20000  // spins (~50us) before a thread goes to sleep
+
+// Number of threads for the shared pool, 0 = FT_THREADS or all CPUs.
+inline int thread_pool_threads = 0;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// Sleeps while *addr == value, at most for the relative timeout if given.
+inline void futexWait(std::atomic<int> *addr, int value, const struct timespec *timeout = NULL) {
+    syscall(SYS_futex, (int *)addr, FUTEX_WAIT_PRIVATE, value, timeout, NULL, 0);
+}
+
+inline void futexWakeAll(std::atomic<int> *addr) {
+    syscall(SYS_futex, (int *)addr, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+}
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads)
+        : nthreads_((threads < 1) ? 1 : (threads > THREAD_POOL_MAX) ? THREAD_POOL_MAX : threads),
+          ranges_(new Range[nthreads_]) {
+
+        // CPUs we are allowed to run on, for pinning the workers
+        cpu_set_t allowed;
+        std::vector<int> cpus;
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int c=0; c < CPU_SETSIZE; c++) {
+                if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+            }
+        }
+        spin_ = ((size_t)nthreads_ <= cpus.size()) ? THREAD_POOL_SPIN : 0;
+        for (int t=1; t < nthreads_; t++) {
+            workers_.emplace_back(&ThreadPool::WorkerLoop, this, t);
+            if (!cpus.empty()) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpus[t % cpus.size()], &set);
+                pthread_setaffinity_np(workers_.back().native_handle(), sizeof(set), &set);
+            }
+        }
+    }
+
+    ~ThreadPool() {
+        stop_ = true;
+        generation_.fetch_add(1);
+        futexWakeAll(&generation_);
+        for (size_t i=0; i < workers_.size(); i++) {
+            workers_[i].join();
+        }
+        delete [] ranges_;
+    }
+
+    int threads() const { return nthreads_; }
+
+    // Calls fn(handle, t) for every worker t = 1 .. threads() - 1, e.g. to
+    // change its scheduling.
+    template <class Fn>
+    void ForEachWorker(Fn fn) {
+        for (size_t i=0; i < workers_.size(); i++) {
+            fn(workers_[i].native_handle(), (int)i + 1);
+        }
+    }
+
+    // Calls task(i) for every i in [0, count), spread over the threads, and
+    // returns when all calls are done. Not reentrant.
+    template <class Fn>
+    void Run(int count, Fn &task) {
+        if (nthreads_ == 1 || count <= 1) {
+            for (int i=0; i < count; i++) { task(i); }
+            return;
+        }
+        call_ = [](void *ctx, int i) { (*(Fn *)ctx)(i); };
+        ctx_ = &task;
+        for (int t=0; t < nthreads_; t++) {
+            ranges_[t].next.store((int)((long)count * t / nthreads_), std::memory_order_relaxed);
+            ranges_[t].end = (int)((long)count * (t + 1) / nthreads_);
+        }
+        pending_.store(nthreads_ - 1);
+        generation_.fetch_add(1);
+        if (sleepers_.load() > 0) {
+            futexWakeAll(&generation_);
+        }
+
+        Work(0);
+
+        // wait for the workers, spinning first
+        for (int spin=0; pending_.load() > 0; spin++) {
+            if (spin < spin_) {
+                cpuRelax();
+                continue;
+            }
+            caller_sleeping_.store(1);
+            const int left = pending_.load();
+            if (left > 0) {
+                futexWait(&pending_, left);
+            }
+            caller_sleeping_.store(0);
+        }
+    }
+
+private:
+    struct alignas(64) Range {
+        std::atomic<int> next;
+        int end;
+    };
+
+    // Own share of the tasks first, then steal from the others.
+    void Work(int self) {
+        for (int k=0; k < nthreads_; k++) {
+            Range &r = ranges_[(self + k) % nthreads_];
+            for (;;) {
+                const int i = r.next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= r.end) break;
+                call_(ctx_, i);
+            }
+        }
+    }
+
+    void WorkerLoop(int self) {
+        int seen = 0;  // not generation_, a job may already be waiting
+        for (;;) {
+            // wait for the next job, spinning first
+            for (int spin=0; generation_.load() == seen; spin++) {
+                if (spin < spin_) {
+                    cpuRelax();
+                    continue;
+                }
+                sleepers_.fetch_add(1);
+                if (generation_.load() == seen) {
+                    futexWait(&generation_, seen);
+                }
+                sleepers_.fetch_sub(1);
+            }
+            seen = generation_.load();
+            if (stop_) return;
+
+            Work(self);
+
+            if (pending_.fetch_sub(1) == 1 && caller_sleeping_.load()) {
+                futexWakeAll(&pending_);
+            }
+        }
+    }
+
+    int nthreads_;
+    int spin_ = 0;
+    Range *ranges_;
+    std::vector<std::thread> workers_;
+    void (*call_)(void *ctx, int i) = NULL;
+    void *ctx_ = NULL;
+    std::atomic<bool> stop_{false};
+    alignas(64) std::atomic<int> generation_{0};
+    std::atomic<int> sleepers_{0};
+    alignas(64) std::atomic<int> pending_{0};
+    std::atomic<int> caller_sleeping_{0};
+};
+
+// The pool shared by all kernels, created on first use.
+inline ThreadPool &demoThreadPool() {
+    static ThreadPool pool([] {
+        if (thread_pool_threads > 0) return thread_pool_threads;
+        const char *env = getenv("FT_THREADS");
+        if (env && atoi(env) > 0) return atoi(env);
+        const int cpus = (int)std::thread::hardware_concurrency();
+        return (cpus > 0) ? cpus : 1;
+    }());
+    return pool;
+}
+
+// ------------------------------------------------------------------------------------------
+// Tiles
+
+struct Tile {
+    int x0, y0, x1, y1;     // pixels [x0, x1) x [y0, y1)
+    int index;              // 0 .. tileCount() - 1, row by row
+};
+
+inline int tileCount(int width, int height, int tile) {
+    return ((width + tile - 1) / tile) * ((height + tile - 1) / tile);
+}
+
+// Calls fn(const Tile &) for every tile x tile block of a width x height area
+// (smaller at the right and bottom edges), in parallel.
+template <class Fn>
+void parallelForTiles(int width, int height, int tile, Fn fn) {
+    const int tiles_x = (width + tile - 1) / tile;
+    auto task = [&](int i) {
+        Tile t;
+        t.index = i;
+        t.x0 = (i % tiles_x) * tile;
+        t.y0 = (i / tiles_x) * tile;
+        t.x1 = (t.x0 + tile < width) ? t.x0 + tile : width;
+        t.y1 = (t.y0 + tile < height) ? t.y0 + tile : height;
+        fn(t);
+    };
+    demoThreadPool().Run(tileCount(width, height, tile), task);
+}
+
+#endif  // THREAD_POOL_H